@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationArena.cpp
+ * @brief   Per-thread recycling of the matrix storage of temporary factors and conditionals
+ * @date    Oct 2026
+ */
+
+#include <gtsam/base/EliminationArena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace gtsam {
+
+namespace {
+
+// Storage released beyond this many bytes per thread is freed
+const size_t maxBytesPerThread = size_t(256) << 20;
+
+std::atomic<size_t> nrScopes(0);
+std::atomic<size_t> currentIteration(0);
+
+// The scope enabled in this thread, either opened by it or adopted by a task
+thread_local const EliminationArena::Scope* currentScope = nullptr;
+
+/* ************************************************************************* */
+struct Arena;
+
+// All arenas, so that they can be trimmed together
+std::mutex& registryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<Arena*>& registry() {
+  static std::vector<Arena*> arenas;
+  return arenas;
+}
+
+/* ************************************************************************* */
+struct Arena {
+  struct Buffer {
+    Matrix matrix;
+    size_t iteration; // The iteration in which it was released
+  };
+
+  // Protects the buffers, which other threads access in NextIteration and clear
+  std::mutex mutex;
+  std::unordered_map<size_t, std::vector<Buffer> > buffers; // By number of elements
+  size_t bytes;
+
+  Arena() : bytes(0) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+  }
+
+  ~Arena() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().erase(std::find(registry().begin(), registry().end(), this));
+  }
+
+  // Free the buffers for which keep returns false
+  template <class PREDICATE>
+  void trim(const PREDICATE& keep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = buffers.begin(); it != buffers.end();) {
+      std::vector<Buffer>& sameSize = it->second;
+      auto end = std::partition(sameSize.begin(), sameSize.end(), keep);
+      bytes -= (sameSize.end() - end) * it->first * sizeof(double);
+      sameSize.erase(end, sameSize.end());
+      if (sameSize.empty())
+        it = buffers.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  static Arena& Local() {
+    static thread_local Arena arena;
+    return arena;
+  }
+};
+
+/* ************************************************************************* */
+template <class PREDICATE>
+void trimAll(const PREDICATE& keep) {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for (Arena* arena : registry())
+    arena->trim(keep);
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+EliminationArena::Scope::Scope() : previous_(currentScope) {
+  ++nrScopes;
+  currentScope = this;
+}
+
+/* ************************************************************************* */
+EliminationArena::Scope::~Scope() {
+  currentScope = previous_;
+  if (--nrScopes == 0)
+    trimAll([](const Arena::Buffer&) { return false; });
+}
+
+/* ************************************************************************* */
+EliminationArena::TaskScope::TaskScope(const Scope* scope) : previous_(currentScope) {
+  currentScope = scope;
+}
+
+/* ************************************************************************* */
+EliminationArena::TaskScope::~TaskScope() {
+  currentScope = previous_;
+}
+
+/* ************************************************************************* */
+const EliminationArena::Scope* EliminationArena::CurrentScope() {
+  return currentScope;
+}
+
+/* ************************************************************************* */
+void EliminationArena::Resize(Matrix& matrix, DenseIndex rows, DenseIndex cols) {
+  const size_t size = static_cast<size_t>(rows * cols);
+  if (Enabled() && size > 0 && static_cast<size_t>(matrix.size()) != size) {
+    Release(matrix);
+    Arena& arena = Arena::Local();
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    auto it = arena.buffers.find(size);
+    if (it != arena.buffers.end()) {
+      // Take the most recently released buffer, and resize it without reallocation
+      matrix = std::move(it->second.back().matrix);
+      it->second.pop_back();
+      if (it->second.empty())
+        arena.buffers.erase(it);
+      arena.bytes -= size * sizeof(double);
+    }
+  }
+  matrix.resize(rows, cols);
+}
+
+/* ************************************************************************* */
+void EliminationArena::Release(Matrix& matrix) {
+  const size_t size = static_cast<size_t>(matrix.size());
+  if (!Enabled() || size == 0)
+    return;
+  Arena& arena = Arena::Local();
+  std::lock_guard<std::mutex> lock(arena.mutex);
+  if (arena.bytes + size * sizeof(double) > maxBytesPerThread)
+    return;
+  arena.buffers[size].push_back(Arena::Buffer{std::move(matrix), currentIteration});
+  arena.bytes += size * sizeof(double);
+  matrix.resize(0, 0);
+}
+
+/* ************************************************************************* */
+void EliminationArena::NextIteration() {
+  const size_t iteration = ++currentIteration;
+  trimAll([iteration](const Arena::Buffer& buffer) { return buffer.iteration + 1 >= iteration; });
+}
+
+/* ************************************************************************* */
+size_t EliminationArena::HeldBytes() {
+  size_t bytes = 0;
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for (Arena* arena : registry()) {
+    std::lock_guard<std::mutex> arenaLock(arena->mutex);
+    bytes += arena->bytes;
+  }
+  return bytes;
+}
+
+}
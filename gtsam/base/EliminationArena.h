@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    EliminationArena.h
+ * @brief   Per-thread recycling of the matrix storage of temporary factors and conditionals
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/dllexport.h>
+
+namespace gtsam {
+
+  /**
+   * Per-thread pools of dense matrix storage for the factors and conditionals created during
+   * elimination.  In the thread that opened an EliminationArena::Scope, and in the TaskGroup tasks
+   * it runs, SymmetricBlockMatrix and VerticalBlockMatrix (and hence HessianFactor,
+   * JacobianFactor and GaussianConditional) give their storage to the arena of the destroying
+   * thread instead of freeing it, and take storage of the same size from the arena of the
+   * allocating thread instead of allocating it.  Each thread has its own arena, so the threads
+   * eliminating cliques in parallel do not contend for the global heap.  Eliminations in other
+   * threads are not affected.
+   *
+   * The cliques eliminated by an optimizer usually have the same sizes from one iteration to the
+   * next, so most of the storage of an iteration is reused from the previous one.
+   * NextIteration() frees the storage that stayed unused for a whole iteration.
+   *
+   * Eigen matrices cannot take a custom allocator, so rather than carving matrices out of large
+   * blocks, the arena keeps whole buffers and hands them out by number of elements.
+   */
+  class GTSAM_EXPORT EliminationArena
+  {
+  public:
+    /** Enables the arenas in the calling thread, and in the tasks it runs, while alive.  Scopes
+     *  may be nested, and alive in several threads at once; the storage held by the arenas is
+     *  freed when the last one ends.  A Scope must be destroyed by the thread that created it. */
+    class GTSAM_EXPORT Scope
+    {
+    public:
+      Scope();
+      ~Scope();
+
+    private:
+      const Scope* previous_; ///< The scope of the calling thread before this one
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+    };
+
+    /** Enables the arenas in the calling thread for the Scope of another thread, while alive.
+     *  TaskGroup uses this to run the tasks of a thread that has a Scope in the same Scope. */
+    class GTSAM_EXPORT TaskScope
+    {
+    public:
+      explicit TaskScope(const Scope* scope);
+      ~TaskScope();
+
+    private:
+      const Scope* previous_; ///< The scope of the calling thread before this one
+
+      TaskScope(const TaskScope&) = delete;
+      TaskScope& operator=(const TaskScope&) = delete;
+    };
+
+    /** The Scope enabled in the calling thread, or a null pointer */
+    static const Scope* CurrentScope();
+
+    /** Whether the arenas are enabled in the calling thread */
+    static bool Enabled() { return CurrentScope() != nullptr; }
+
+    /** Resize \c matrix to \c rows x \c cols like Matrix::resize, taking storage of that size from
+     *  the arena of the calling thread if it is enabled and has some.  The contents are undefined. */
+    static void Resize(Matrix& matrix, DenseIndex rows, DenseIndex cols);
+
+    /** Give the storage of \c matrix to the arena of the calling thread if it is enabled and not
+     *  full, leaving \c matrix empty.  Does nothing otherwise. */
+    static void Release(Matrix& matrix);
+
+    /** Mark the end of an optimizer iteration: free the storage that was released to any arena
+     *  before the previous call and was not reused since. */
+    static void NextIteration();
+
+    /** The number of bytes of storage held by the arenas of all threads */
+    static size_t HeldBytes();
+  };
+
+}
@@ -32,7 +32,7 @@ SymmetricBlockMatrix SymmetricBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(other.cols(), other.cols());
+  EliminationArena::Resize(result.matrix_, other.cols(), other.cols());
   result.assertInvariants();
   return result;
 }
@@ -45,7 +45,7 @@ SymmetricBlockMatrix SymmetricBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(other.cols(), other.cols());
+  EliminationArena::Resize(result.matrix_, other.cols(), other.cols());
   result.assertInvariants();
   return result;
 }
@@ -17,6 +17,7 @@
 */
 #pragma once
 
+#include <gtsam/base/EliminationArena.h>
 #include <gtsam/base/FastVector.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/types.h>
@@ -76,7 +77,8 @@ namespace gtsam {
       blockStart_(0)
     {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
-      matrix_.setZero(variableColOffsets_.back(), variableColOffsets_.back());
+      EliminationArena::Resize(matrix_, variableColOffsets_.back(), variableColOffsets_.back());
+      matrix_.setZero();
       assertInvariants();
     }
 
@@ -86,7 +88,8 @@ namespace gtsam {
       blockStart_(0)
     {
       fillOffsets(firstBlockDim, lastBlockDim, appendOneDimension);
-      matrix_.setZero(variableColOffsets_.back(), variableColOffsets_.back());
+      EliminationArena::Resize(matrix_, variableColOffsets_.back(), variableColOffsets_.back());
+      matrix_.setZero();
       assertInvariants();
     }
 
@@ -95,7 +98,8 @@ namespace gtsam {
     SymmetricBlockMatrix(const CONTAINER& dimensions, const Matrix& matrix, bool appendOneDimension = false) :
       blockStart_(0)
     {
-      matrix_.setZero(matrix.rows(), matrix.cols());
+      EliminationArena::Resize(matrix_, matrix.rows(), matrix.cols());
+      matrix_.setZero();
       matrix_.triangularView<Eigen::Upper>() = matrix.triangularView<Eigen::Upper>();
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
       if(matrix_.rows() != matrix_.cols())
@@ -105,6 +109,14 @@ namespace gtsam {
       assertInvariants();
     }
 
+    SymmetricBlockMatrix(const SymmetricBlockMatrix&) = default;
+    SymmetricBlockMatrix(SymmetricBlockMatrix&&) = default;
+    SymmetricBlockMatrix& operator=(const SymmetricBlockMatrix&) = default;
+    SymmetricBlockMatrix& operator=(SymmetricBlockMatrix&&) = default;
+
+    /// Destructor, gives the matrix storage to the EliminationArena if it is enabled
+    ~SymmetricBlockMatrix() { EliminationArena::Release(matrix_); }
+
     /// Copy the block structure, but do not copy the matrix data.  If blockStart() has been
     /// modified, this copies the structure of the corresponding matrix view. In the destination
     /// SymmetricBlockMatrix, blockStart() will be 0.
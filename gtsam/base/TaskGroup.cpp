@@ -0,0 +1,407 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TaskGroup.cpp
+ * @brief   Scheduler interface for running groups of parallel tasks, backed by TBB or by a
+ *          built-in work-stealing thread pool
+ * @date    Oct 2026
+ */
+
+#include <gtsam/base/TaskGroup.h>
+#include <gtsam/base/EliminationArena.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace gtsam {
+
+namespace {
+// A task that runs in the EliminationArena scope of the thread that scheduled it, and not in the
+// one of the thread that happens to run it
+struct ScopedTask {
+  std::function<void()> task;
+  const EliminationArena::Scope* scope;
+  void operator()() const {
+    EliminationArena::TaskScope taskScope(scope);
+    task();
+  }
+};
+}
+
+/* ************************************************************************* */
+struct ThreadPool::Impl {
+  struct Task {
+    std::function<void()> function;
+    TaskGroup::State* group;
+  };
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // One queue per worker thread, followed by a shared queue for all other threads
+  std::vector<std::unique_ptr<TaskQueue> > queues;
+  std::vector<std::thread> workers;
+
+  std::atomic<size_t> nrQueued; // Number of tasks in all queues
+  std::mutex sleepMutex;
+  std::condition_variable wakeUp;
+  bool stop;
+
+  Impl() : nrQueued(0), stop(false) {}
+  ~Impl() { stopWorkers(); }
+
+  // Index of the queue owned by the calling thread in the pool it is a worker of
+  static thread_local const Impl* currentPool;
+  static thread_local size_t currentQueue;
+
+  size_t ownQueue() const {
+    return currentPool == this ? currentQueue : queues.size() - 1;
+  }
+
+  /* ************************************************************************* */
+  void startWorkers(size_t nrWorkers) {
+    stop = false;
+    queues.clear();
+    for (size_t i = 0; i <= nrWorkers; ++i)
+      queues.emplace_back(new TaskQueue());
+    for (size_t i = 0; i < nrWorkers; ++i)
+      workers.emplace_back([this, i]() { workerLoop(i); });
+  }
+
+  /* ************************************************************************* */
+  void stopWorkers() {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      stop = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& worker : workers)
+      worker.join();
+    workers.clear();
+  }
+
+  /* ************************************************************************* */
+  void push(Task&& task) {
+    TaskQueue& queue = *queues[ownQueue()];
+    ++nrQueued;
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    // Lock so that a worker cannot miss the notification between checking nrQueued and waiting
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeUp.notify_one();
+  }
+
+  /* ************************************************************************* */
+  bool pop(Task& task) {
+    // Take our most recent task, which is likely to be hot in cache
+    const size_t own = ownQueue();
+    {
+      TaskQueue& queue = *queues[own];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        --nrQueued;
+        return true;
+      }
+    }
+    // Otherwise steal the oldest task of another queue, which is likely to be the largest
+    for (size_t k = 1; k < queues.size(); ++k) {
+      TaskQueue& queue = *queues[(own + k) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        --nrQueued;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* ************************************************************************* */
+  static void execute(Task& task) {
+    // Skip the remaining tasks of a group in which a task has failed
+    if (!task.group->failed) {
+      try {
+        task.function();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(task.group->mutex);
+        if (!task.group->exception)
+          task.group->exception = std::current_exception();
+        task.group->failed = true;
+      }
+    }
+  }
+
+  /* ************************************************************************* */
+  void complete(Task& task) {
+    execute(task);
+    // This must be the last access to the group, which may be destroyed as soon as it is done.
+    // Lock so that a thread waiting for the group cannot miss the notification.
+    if (--task.group->pending == 0) {
+      { std::lock_guard<std::mutex> lock(sleepMutex); }
+      wakeUp.notify_all();
+    }
+  }
+
+  /* ************************************************************************* */
+  void workerLoop(size_t i) {
+    currentPool = this;
+    currentQueue = i;
+    for (;;) {
+      Task task;
+      if (pop(task)) {
+        complete(task);
+      } else {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stop || nrQueued > 0; });
+        if (stop)
+          break;
+      }
+    }
+    currentPool = nullptr;
+  }
+};
+
+thread_local const ThreadPool::Impl* ThreadPool::Impl::currentPool = nullptr;
+thread_local size_t ThreadPool::Impl::currentQueue = 0;
+
+/* ************************************************************************* */
+ThreadPool::ThreadPool() : impl_(new Impl()) {
+  const size_t hardwareThreads = std::thread::hardware_concurrency();
+  impl_->startWorkers(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+}
+
+/* ************************************************************************* */
+ThreadPool::~ThreadPool() {}
+
+/* ************************************************************************* */
+ThreadPool& ThreadPool::Instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+/* ************************************************************************* */
+size_t ThreadPool::nrThreads() const {
+  return impl_->workers.size() + 1;
+}
+
+/* ************************************************************************* */
+void ThreadPool::setNrThreads(size_t nrThreads) {
+  impl_->stopWorkers();
+  impl_->startWorkers(nrThreads > 1 ? nrThreads - 1 : 0);
+}
+
+#ifdef GTSAM_USE_TBB
+
+namespace {
+// The arena of the innermost ConcurrencyScope, if any
+tbb::task_arena* scopeArena = nullptr;
+
+// Call f in the arena of the innermost ConcurrencyScope, or in the current one
+template<typename F>
+void inArena(const F& f) {
+  if (scopeArena)
+    scopeArena->execute(f);
+  else
+    f();
+}
+}
+
+/* ************************************************************************* */
+struct ConcurrencyScope::Impl {
+  tbb::global_control control;
+  tbb::task_arena arena;
+  tbb::task_arena* previous;
+  Impl(size_t nrThreads)
+      : control(tbb::global_control::max_allowed_parallelism, nrThreads),
+        arena(static_cast<int>(nrThreads)),
+        previous(scopeArena) {}
+};
+
+/* ************************************************************************* */
+ConcurrencyScope::ConcurrencyScope(size_t nrThreads)
+    : impl_(new Impl(std::max(nrThreads, size_t(1)))) {
+  scopeArena = &impl_->arena;
+}
+
+/* ************************************************************************* */
+ConcurrencyScope::~ConcurrencyScope() {
+  scopeArena = impl_->previous;
+}
+
+/* ************************************************************************* */
+TaskGroup::TaskGroup() {}
+
+/* ************************************************************************* */
+TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+  }
+}
+
+/* ************************************************************************* */
+void TaskGroup::run(std::function<void()> task) {
+  inArena([this, &task]() {
+    group_.run(ScopedTask{std::move(task), EliminationArena::CurrentScope()});
+  });
+}
+
+/* ************************************************************************* */
+void TaskGroup::wait() {
+  inArena([this]() { group_.wait(); });
+}
+
+/* ************************************************************************* */
+size_t TaskGroup::MaxConcurrency() {
+  if (scopeArena)
+    return static_cast<size_t>(scopeArena->max_concurrency());
+  return static_cast<size_t>(tbb::this_task_arena::max_concurrency());
+}
+
+/* ************************************************************************* */
+void ParallelFor(size_t begin, size_t end, size_t grainSize,
+                 const std::function<void(size_t, size_t)>& body) {
+  const EliminationArena::Scope* scope = EliminationArena::CurrentScope();
+  inArena([&]() {
+    tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, std::max(grainSize, size_t(1))),
+                      [&body, scope](const tbb::blocked_range<size_t>& range) {
+                        EliminationArena::TaskScope taskScope(scope);
+                        body(range.begin(), range.end());
+                      });
+  });
+}
+
+#else
+
+/* ************************************************************************* */
+struct ConcurrencyScope::Impl {
+  size_t previous;
+};
+
+/* ************************************************************************* */
+ConcurrencyScope::ConcurrencyScope(size_t nrThreads) : impl_(new Impl()) {
+#ifdef GTSAM_USE_THREADPOOL
+  ThreadPool& pool = ThreadPool::Instance();
+  impl_->previous = pool.nrThreads();
+  pool.setNrThreads(nrThreads);
+#endif
+}
+
+/* ************************************************************************* */
+ConcurrencyScope::~ConcurrencyScope() {
+#ifdef GTSAM_USE_THREADPOOL
+  ThreadPool::Instance().setNrThreads(impl_->previous);
+#endif
+}
+
+/* ************************************************************************* */
+TaskGroup::TaskGroup() {}
+
+/* ************************************************************************* */
+TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+  }
+}
+
+/* ************************************************************************* */
+void TaskGroup::run(std::function<void()> task) {
+#ifdef GTSAM_USE_THREADPOOL
+  ++state_.pending;
+  ThreadPool::Instance().impl_->push(ThreadPool::Impl::Task{
+      ScopedTask{std::move(task), EliminationArena::CurrentScope()}, &state_});
+#else
+  // Parallel algorithms run serially, so do not start any threads
+  ThreadPool::Impl::Task serial{std::move(task), &state_};
+  ThreadPool::Impl::execute(serial);
+#endif
+}
+
+/* ************************************************************************* */
+void TaskGroup::wait() {
+#ifdef GTSAM_USE_THREADPOOL
+  // Help with pending tasks, ours or others', until all of ours are done, and sleep while there
+  // are none to help with
+  ThreadPool::Impl& pool = *ThreadPool::Instance().impl_;
+  while (state_.pending > 0) {
+    ThreadPool::Impl::Task task;
+    if (pool.pop(task)) {
+      pool.complete(task);
+    } else {
+      std::unique_lock<std::mutex> lock(pool.sleepMutex);
+      pool.wakeUp.wait(lock, [this, &pool]() { return state_.pending == 0 || pool.nrQueued > 0; });
+    }
+  }
+#endif
+
+  // Rethrow the first exception, if any
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(state_.mutex);
+    std::swap(exception, state_.exception);
+    state_.failed = false;
+  }
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+/* ************************************************************************* */
+void ParallelFor(size_t begin, size_t end, size_t grainSize,
+                 const std::function<void(size_t, size_t)>& body) {
+  if (end <= begin)
+    return;
+  grainSize = std::max(grainSize, size_t(1));
+  const size_t threads = TaskGroup::MaxConcurrency();
+  if (threads <= 1 || end - begin <= grainSize) {
+    body(begin, end);
+    return;
+  }
+
+  // A few ranges per thread, so that threads that finish early can take over some of the work
+  const size_t rangeSize = std::max(grainSize, (end - begin + 4 * threads - 1) / (4 * threads));
+  TaskGroup group;
+  for (size_t first = begin; first < end; first += rangeSize) {
+    const size_t last = std::min(end, first + rangeSize);
+    group.run([&body, first, last]() { body(first, last); });
+  }
+  group.wait();
+}
+
+/* ************************************************************************* */
+size_t TaskGroup::MaxConcurrency() {
+#ifdef GTSAM_USE_THREADPOOL
+  return ThreadPool::Instance().nrThreads();
+#else
+  return 1;
+#endif
+}
+
+#endif
+
+}
@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    TaskGroup.h
+ * @brief   Scheduler interface for running groups of parallel tasks, backed by TBB or by a
+ *          built-in work-stealing thread pool
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/task_group.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace gtsam {
+
+  /**
+   * A group of tasks that may run in parallel, and that can be waited for together.  This is the
+   * scheduler interface used by the parallel algorithms in GTSAM (e.g. parallel tree traversal
+   * for elimination).  The backend is chosen when GTSAM is compiled: with TBB, tasks are run
+   * by a tbb::task_group; otherwise they are run by the built-in ThreadPool.
+   *
+   * Tasks may create task groups of their own.  A thread waiting for a group keeps executing
+   * pending tasks, so nested waits do not block worker threads.  If a task throws, the tasks of
+   * the group that have not started yet are skipped, and the first exception is rethrown by
+   * wait() once the running tasks have finished.
+   */
+  class GTSAM_EXPORT TaskGroup
+  {
+  public:
+    /** Construct an empty task group */
+    TaskGroup();
+
+    /** Waits for all tasks that are still running, ignoring their exceptions */
+    ~TaskGroup();
+
+    /** Schedule \c task to run, possibly in parallel with the calling thread */
+    void run(std::function<void()> task);
+
+    /** Wait for all scheduled tasks to finish, and rethrow the first exception thrown by any */
+    void wait();
+
+    /** The number of threads that parallel algorithms can expect to keep busy: the TBB
+     *  concurrency, the size of the ThreadPool if GTSAM uses it, or 1 if parallel algorithms
+     *  run serially (i.e. GTSAM_USE_TBB and GTSAM_USE_THREADPOOL are both undefined).  A
+     *  ConcurrencyScope overrides the first two. */
+    static size_t MaxConcurrency();
+
+    /// Completion state of a group, shared with the ThreadPool (internal)
+    struct State {
+      std::atomic<size_t> pending; ///< Number of tasks not yet finished
+      std::atomic<bool> failed; ///< Whether a task has thrown
+      std::mutex mutex; ///< Protects exception
+      std::exception_ptr exception; ///< The first exception thrown by a task
+      State() : pending(0), failed(false) {}
+    };
+
+  private:
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+#ifdef GTSAM_USE_TBB
+    tbb::task_group group_;
+#else
+    State state_;
+#endif
+  };
+
+  /**
+   * Call \c body(first, last) on consecutive ranges [first, last) that cover [begin, end), possibly
+   * in parallel, and wait for all of them.  Ranges have at least \c grainSize indices, except
+   * possibly the last one.  This uses tbb::parallel_for with TBB, and a TaskGroup otherwise.  The
+   * first exception thrown by \c body is rethrown.
+   */
+  GTSAM_EXPORT void ParallelFor(size_t begin, size_t end, size_t grainSize,
+                                const std::function<void(size_t, size_t)>& body);
+
+  /**
+   * Runs the task groups and parallel loops started while it is in scope on \c nrThreads
+   * threads, which may be more than there are cores, e.g. to exercise the parallel code paths in
+   * unit tests.  With TBB this uses a task_arena of that size and raises the TBB parallelism
+   * limit accordingly; with the ThreadPool it resizes the pool, and restores its size when it
+   * goes out of scope.  It has no effect if parallel algorithms run serially.  No tasks may be
+   * running when a ConcurrencyScope is created or destroyed, and scopes must not overlap in
+   * different threads.
+   */
+  class GTSAM_EXPORT ConcurrencyScope
+  {
+  public:
+    explicit ConcurrencyScope(size_t nrThreads);
+    ~ConcurrencyScope();
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    ConcurrencyScope(const ConcurrencyScope&) = delete;
+    ConcurrencyScope& operator=(const ConcurrencyScope&) = delete;
+  };
+
+  /**
+   * A lightweight work-stealing thread pool, the TaskGroup backend for builds without TBB.  Each
+   * worker thread owns a task queue: it runs its own most recent task first and, when its queue
+   * is empty, steals the oldest task of another worker.  There is a single pool per process,
+   * which is started the first time it is used.
+   */
+  class GTSAM_EXPORT ThreadPool
+  {
+  public:
+    /** The thread pool of this process.  It is only used when GTSAM_USE_THREADPOOL is
+     *  defined, otherwise this starts a pool that no task group runs tasks on. */
+    static ThreadPool& Instance();
+
+    /** Stops all worker threads */
+    ~ThreadPool();
+
+    /** The number of threads running tasks, including the thread waiting for them */
+    size_t nrThreads() const;
+
+    /** Restart the pool with \c nrThreads threads including the waiting thread, so that 1 runs all
+     *  tasks serially in the thread that waits for them.  The default is the number of hardware
+     *  threads.  No tasks may be running when this is called. */
+    void setNrThreads(size_t nrThreads);
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    friend class TaskGroup;
+  };
+
+}
@@ -29,7 +29,7 @@ VerticalBlockMatrix VerticalBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(other.rows(), result.variableColOffsets_.back());
+  EliminationArena::Resize(result.matrix_, other.rows(), result.variableColOffsets_.back());
   result.rowEnd_ = other.rows();
   result.assertInvariants();
   return result;
@@ -43,7 +43,7 @@ VerticalBlockMatrix VerticalBlockMatrix::LikeActiveViewOf(
   for (size_t i = 0; i < result.variableColOffsets_.size(); ++i)
     result.variableColOffsets_[i] = other.variableColOffsets_[other.blockStart_
         + i] - other.variableColOffsets_[other.blockStart_];
-  result.matrix_.resize(height, result.variableColOffsets_.back());
+  EliminationArena::Resize(result.matrix_, height, result.variableColOffsets_.back());
   result.rowEnd_ = height;
   result.assertInvariants();
   return result;
@@ -19,6 +19,7 @@
 
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/FastVector.h>
+#include <gtsam/base/EliminationArena.h>
 
 namespace gtsam {
 
@@ -70,7 +71,7 @@ namespace gtsam {
         variableColOffsets_(dimensions.size() + (appendOneDimension ? 2 : 1)),
         rowStart_(0), rowEnd_(height), blockStart_(0) {
       fillOffsets(dimensions.begin(), dimensions.end(), appendOneDimension);
-      matrix_.resize(height, variableColOffsets_.back());
+      EliminationArena::Resize(matrix_, height, variableColOffsets_.back());
       assertInvariants();
     }
 
@@ -94,10 +95,18 @@ namespace gtsam {
         variableColOffsets_((lastBlockDim-firstBlockDim) + (appendOneDimension ? 2 : 1)),
         rowStart_(0), rowEnd_(height), blockStart_(0) {
       fillOffsets(firstBlockDim, lastBlockDim, appendOneDimension);
-      matrix_.resize(height, variableColOffsets_.back());
+      EliminationArena::Resize(matrix_, height, variableColOffsets_.back());
       assertInvariants();
     }
 
+    VerticalBlockMatrix(const VerticalBlockMatrix&) = default;
+    VerticalBlockMatrix(VerticalBlockMatrix&&) = default;
+    VerticalBlockMatrix& operator=(const VerticalBlockMatrix&) = default;
+    VerticalBlockMatrix& operator=(VerticalBlockMatrix&&) = default;
+
+    /** Destructor, gives the matrix storage to the EliminationArena if it is enabled */
+    ~VerticalBlockMatrix() { EliminationArena::Release(matrix_); }
+
     /** Copy the block structure and resize the underlying matrix, but do not copy the matrix data.
     *  If blockStart(), rowStart(), and/or rowEnd() have been modified, this copies the structure of
     *  the corresponding matrix view. In the destination VerticalBlockView, blockStart() and
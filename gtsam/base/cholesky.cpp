@@ -19,6 +19,7 @@
 
 #include <gtsam/base/cholesky.h>
 #include <gtsam/base/timing.h>
+#include <gtsam/base/TaskGroup.h>
 
 #include <boost/format.hpp>
 #include <cmath>
@@ -32,6 +33,27 @@ static const double zeroPivotThreshold = 1e-6;
 static const double underconstrainedPrior = 1e-5;
 static const int underconstrainedExponentDifference = 12;
 
+// Block size of the parallel choleskyPartial, in columns
+static const size_t parallelBlockSize = 64;
+
+static thread_local bool choleskyParallelEnabled = false;
+
+/* ************************************************************************* */
+CholeskyParallelScope::CholeskyParallelScope(bool enable)
+    : previous_(choleskyParallelEnabled) {
+  choleskyParallelEnabled = enable;
+}
+
+/* ************************************************************************* */
+CholeskyParallelScope::~CholeskyParallelScope() {
+  choleskyParallelEnabled = previous_;
+}
+
+/* ************************************************************************* */
+bool CholeskyParallelScope::Enabled() {
+  return choleskyParallelEnabled;
+}
+
 /* ************************************************************************* */
 static inline int choleskyStep(Matrix& ATA, size_t k, size_t order) {
   // Get pivot value
@@ -104,6 +126,60 @@ pair<size_t, bool> choleskyCareful(Matrix& ATA, int order) {
   return make_pair(maxrank, success);
 }
 
+/* ************************************************************************* */
+// Call f(j, w) for each block [j, j + w) of n columns in a parallel task, and wait for all.  The
+// last blocks are started first, as they have the most rows in a trailing triangle update.
+template <class FUNCTION>
+static void forEachColumnBlock(TaskGroup& group, size_t n, const FUNCTION& f) {
+  const size_t nrBlocks = (n + parallelBlockSize - 1) / parallelBlockSize;
+  for (size_t b = nrBlocks; b-- > 0;) {
+    const size_t j = b * parallelBlockSize;
+    const size_t w = std::min(parallelBlockSize, n - j);
+    group.run([&f, j, w]() { f(j, w); });
+  }
+  group.wait();
+}
+
+/* ************************************************************************* */
+// Blocked right-looking version of choleskyPartial on the symmetric matrix with upper triangle
+// M.  Each step factors a diagonal block of up to parallelBlockSize frontal columns with Eigen's
+// LLT, then computes the corresponding rows of R and S and updates the trailing upper triangle,
+// both split over parallel tasks by blocks of columns.
+static bool choleskyPartialParallel(Eigen::Block<Matrix> M, size_t nFrontal) {
+  const size_t n = static_cast<size_t>(M.rows());
+  TaskGroup group;
+  for (size_t k = 0; k < nFrontal; k += parallelBlockSize) {
+    // Factor the diagonal block
+    const size_t nb = std::min(parallelBlockSize, nFrontal - k);
+    auto Akk = M.block(k, k, nb, nb);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(Akk);
+    if (llt.info() != Eigen::Success)
+      return false;
+    Akk.triangularView<Eigen::Upper>() = llt.matrixU();
+
+    const size_t o = k + nb, rest = n - o;
+    if (rest == 0)
+      break;
+    const auto Rkk = Akk.triangularView<Eigen::Upper>();
+    auto X = M.block(k, o, nb, rest);
+    auto T = M.block(o, o, rest, rest);
+
+    // Compute the rest of this block of rows, X = inv(Rkk') * X
+    forEachColumnBlock(group, rest, [&](size_t j, size_t w) {
+      Rkk.transpose().solveInPlace(X.middleCols(j, w));
+    });
+
+    // Update the upper triangle of the trailing matrix, T = T - X' * X
+    forEachColumnBlock(group, rest, [&](size_t j, size_t w) {
+      T.block(j, j, w, w).selfadjointView<Eigen::Upper>().rankUpdate(
+          X.middleCols(j, w).transpose(), -1.0);
+      if (j > 0)
+        T.block(0, j, j, w).noalias() -= X.leftCols(j).transpose() * X.middleCols(j, w);
+    });
+  }
+  return true;
+}
+
 /* ************************************************************************* */
 bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   gttic(choleskyPartial);
@@ -115,32 +191,42 @@ bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft) {
   const size_t n = static_cast<size_t>(ABC.rows() - topleft);
   assert(nFrontal <= size_t(n));
 
-  // Create views on blocks
-  auto A = ABC.block(topleft, topleft, nFrontal, nFrontal);
-  auto B = ABC.block(topleft, topleft + nFrontal, nFrontal, n - nFrontal);
-  auto C = ABC.block(topleft + nFrontal, topleft + nFrontal, n - nFrontal, n - nFrontal);
-
-  // Compute Cholesky factorization A = R'*R, overwrites A.
-  gttic(LLT);
-  Eigen::LLT<Matrix, Eigen::Upper> llt(A);
-  Eigen::ComputationInfo lltResult = llt.info();
-  if (lltResult != Eigen::Success)
-    return false;
-  auto R = A.triangularView<Eigen::Upper>();
-  R = llt.matrixU();
-  gttoc(LLT);
-
-  // Compute S = inv(R') * B
-  gttic(compute_S);
-  if (nFrontal < n)
-    R.transpose().solveInPlace(B);
-  gttoc(compute_S);
-
-  // Compute L = C - S' * S
-  gttic(compute_L);
-  if (nFrontal < n)
-    C.selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
-  gttoc(compute_L);
+  // Factor large matrices with the blocked algorithm in parallel tasks, if allowed
+  if (n >= 2 * parallelBlockSize && CholeskyParallelScope::Enabled()
+      && TaskGroup::MaxConcurrency() > 1) {
+    gttic(choleskyPartialParallel);
+    if (!choleskyPartialParallel(ABC.block(topleft, topleft, n, n), nFrontal))
+      return false;
+    gttoc(choleskyPartialParallel);
+  } else {
+    // Create views on blocks
+    auto A = ABC.block(topleft, topleft, nFrontal, nFrontal);
+    auto B = ABC.block(topleft, topleft + nFrontal, nFrontal, n - nFrontal);
+    auto C = ABC.block(topleft + nFrontal, topleft + nFrontal, n - nFrontal, n - nFrontal);
+
+    // Compute Cholesky factorization A = R'*R, overwrites A.
+    gttic(LLT);
+    Eigen::LLT<Matrix, Eigen::Upper> llt(A);
+    Eigen::ComputationInfo lltResult = llt.info();
+    if (lltResult != Eigen::Success)
+      return false;
+    A.triangularView<Eigen::Upper>() = llt.matrixU();
+    gttoc(LLT);
+
+    // Compute S = inv(R') * B
+    gttic(compute_S);
+    if (nFrontal < n)
+      A.triangularView<Eigen::Upper>().transpose().solveInPlace(B);
+    gttoc(compute_S);
+
+    // Compute L = C - S' * S
+    gttic(compute_L);
+    if (nFrontal < n)
+      C.selfadjointView<Eigen::Upper>().rankUpdate(B.transpose(), -1.0);
+    gttoc(compute_L);
+  }
+
+  auto R = ABC.block(topleft, topleft, nFrontal, nFrontal);
 
   // Check last diagonal element - Eigen does not check it
   if (nFrontal >= 2) {
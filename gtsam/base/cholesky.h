@@ -62,5 +62,26 @@ GTSAM_EXPORT std::pair<size_t,bool> choleskyCareful(Matrix& ATA, int order = -1)
  */
 GTSAM_EXPORT bool choleskyPartial(Matrix& ABC, size_t nFrontal, size_t topleft=0);
 
+/**
+ * An object whose scope defines a block where choleskyPartial, when called from the same thread,
+ * may split the computation of \c S and \c L over parallel tasks (see TaskGroup).  Parallel
+ * elimination uses it for the few large cliques near the root of a Bayes tree, when there are
+ * not enough independent subtrees left to keep all threads busy.  Scopes can be nested, the
+ * innermost one decides.
+ */
+class GTSAM_EXPORT CholeskyParallelScope {
+  bool previous_;
+
+public:
+  /// Allow (or, with \c enable false, forbid) parallel choleskyPartial in this scope
+  explicit CholeskyParallelScope(bool enable = true);
+
+  /// Restore the setting of the enclosing scope
+  ~CholeskyParallelScope();
+
+  /// Whether choleskyPartial may use parallel tasks on the calling thread
+  static bool Enabled();
+};
+
 }
 
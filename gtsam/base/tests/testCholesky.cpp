@@ -17,6 +17,7 @@
 
 #include <gtsam/base/debug.h>
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/TaskGroup.h>
 #include <CppUnitLite/TestHarness.h>
 
 using namespace gtsam;
@@ -66,6 +67,45 @@ TEST(cholesky, choleskyPartial) {
   EXPECT(assert_equal(expected, actual, 1e-9));
 }
 
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialParallel) {
+  // A random positive definite matrix with a separator large enough to be split in tasks
+  srand(42);
+  const Matrix M = Matrix::Random(500, 400);
+  const Matrix ABC = M.transpose() * M;
+
+  Matrix expected(ABC);
+  EXPECT(choleskyPartial(expected, 100, 20));
+
+  Matrix actual(ABC);
+  {
+    ConcurrencyScope scope(4);
+    CholeskyParallelScope parallel;
+    EXPECT(CholeskyParallelScope::Enabled());
+    EXPECT(choleskyPartial(actual, 100, 20));
+  }
+  EXPECT(!CholeskyParallelScope::Enabled());
+
+  // Only the upper triangle is defined
+  EXPECT(assert_equal(Matrix(expected.triangularView<Eigen::Upper>()),
+                      Matrix(actual.triangularView<Eigen::Upper>()), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(cholesky, choleskyPartialParallelIndefinite) {
+  // A frontal pivot in the second block of columns is negative
+  srand(42);
+  const Matrix M = Matrix::Random(300, 200);
+  Matrix ABC = M.transpose() * M;
+  ABC(80, 80) = -1.0;
+
+  {
+    ConcurrencyScope scope(4);
+    CholeskyParallelScope parallel;
+    EXPECT(!choleskyPartial(ABC, 100));
+  }
+}
+
 /* ************************************************************************* */
 TEST(cholesky, BadScalingCholesky) {
   Matrix A = (Matrix(2,2) <<
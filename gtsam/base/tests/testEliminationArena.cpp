@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testEliminationArena.cpp
+ * @brief   Unit tests for EliminationArena
+ * @date    Oct 2026
+ */
+
+#include <gtsam/base/EliminationArena.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/TaskGroup.h>
+#include <gtsam/base/VerticalBlockMatrix.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/list_of.hpp>
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+using namespace gtsam;
+using boost::assign::list_of;
+
+/* ************************************************************************* */
+TEST(EliminationArena, Disabled) {
+  EXPECT(!EliminationArena::Enabled());
+  Matrix A(3, 4);
+  EliminationArena::Release(A);
+  EXPECT_LONGS_EQUAL(12, A.size());
+  EXPECT_LONGS_EQUAL(0, EliminationArena::HeldBytes());
+}
+
+/* ************************************************************************* */
+TEST(EliminationArena, Reuse) {
+  {
+    EliminationArena::Scope scope;
+    EXPECT(EliminationArena::Enabled());
+
+    // Released storage is reused for any shape with the same number of elements
+    Matrix A(3, 4);
+    const double* storage = A.data();
+    EliminationArena::Release(A);
+    EXPECT_LONGS_EQUAL(0, A.size());
+    EXPECT_LONGS_EQUAL(12 * sizeof(double), EliminationArena::HeldBytes());
+
+    Matrix B;
+    EliminationArena::Resize(B, 6, 2);
+    EXPECT_LONGS_EQUAL(6, B.rows());
+    EXPECT_LONGS_EQUAL(2, B.cols());
+    EXPECT(B.data() == storage);
+    EXPECT_LONGS_EQUAL(0, EliminationArena::HeldBytes());
+
+    // Block matrices take their storage from the arena and give it back when destroyed
+    EliminationArena::Release(B);
+    {
+      SymmetricBlockMatrix S(list_of(1)(2));
+      VerticalBlockMatrix V(list_of(2)(3)(1), 2);
+      EXPECT(V.matrix().data() == storage);
+    }
+    EXPECT_LONGS_EQUAL(21 * sizeof(double), EliminationArena::HeldBytes());
+
+    // Storage that stays unused for a whole iteration is freed
+    EliminationArena::NextIteration();
+    EXPECT_LONGS_EQUAL(21 * sizeof(double), EliminationArena::HeldBytes());
+    SymmetricBlockMatrix S(list_of(3));
+    Matrix C(5, 1);
+    EliminationArena::Release(C);
+    EXPECT_LONGS_EQUAL(17 * sizeof(double), EliminationArena::HeldBytes());
+    EliminationArena::NextIteration();
+    EXPECT_LONGS_EQUAL(5 * sizeof(double), EliminationArena::HeldBytes());
+    EliminationArena::NextIteration();
+    EXPECT_LONGS_EQUAL(0, EliminationArena::HeldBytes());
+
+    // The arena is freed when the scope ends, even though S gives its storage back
+  }
+  EXPECT(!EliminationArena::Enabled());
+  EXPECT_LONGS_EQUAL(0, EliminationArena::HeldBytes());
+}
+
+/* ************************************************************************* */
+TEST(EliminationArena, ScopeIsPerThread) {
+  EliminationArena::Scope scope;
+
+  // Another thread is not affected by our scope
+  bool otherEnabled = true;
+  std::thread other([&otherEnabled]() { otherEnabled = EliminationArena::Enabled(); });
+  other.join();
+  EXPECT(!otherEnabled);
+
+  // The tasks we run are, whichever thread runs them
+  std::atomic<size_t> nrEnabled(0);
+  {
+    ConcurrencyScope concurrency(4);
+    TaskGroup group;
+    for (size_t i = 0; i < 8; ++i)
+      group.run([&nrEnabled]() {
+        if (EliminationArena::Enabled())
+          ++nrEnabled;
+      });
+    group.wait();
+  }
+  EXPECT_LONGS_EQUAL(8, nrEnabled);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
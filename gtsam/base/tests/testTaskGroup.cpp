@@ -0,0 +1,118 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTaskGroup.cpp
+ * @brief   Unit tests for TaskGroup and ThreadPool
+ * @date    Oct 2026
+ */
+
+#include <gtsam/base/TaskGroup.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+// Count the nodes of a complete binary tree of the given depth, with one task per node
+void countNodes(size_t depth, std::atomic<size_t>& count) {
+  ++count;
+  if (depth == 0)
+    return;
+  TaskGroup group;
+  group.run([depth, &count]() { countNodes(depth - 1, count); });
+  group.run([depth, &count]() { countNodes(depth - 1, count); });
+  group.wait();
+}
+}
+
+/* ************************************************************************* */
+TEST(TaskGroup, NestedTasks) {
+  // Serially, and with more threads than tasks at the first levels
+  for (size_t threads : {size_t(1), size_t(4)}) {
+    ConcurrencyScope scope(threads);
+#if defined(GTSAM_USE_TBB) || defined(GTSAM_USE_THREADPOOL)
+    EXPECT_LONGS_EQUAL(threads, TaskGroup::MaxConcurrency());
+#endif
+    std::atomic<size_t> count(0);
+    countNodes(10, count);
+    EXPECT_LONGS_EQUAL((1 << 11) - 1, count);
+  }
+}
+
+/* ************************************************************************* */
+TEST(TaskGroup, Exception) {
+  ConcurrencyScope scope(4);
+
+  // The exception is rethrown by wait, and tasks that did not start yet may be skipped
+  std::atomic<size_t> count(0);
+  TaskGroup group;
+  for (size_t i = 0; i < 100; ++i)
+    group.run([i, &count]() {
+      if (i == 50)
+        throw std::runtime_error("task failed");
+      ++count;
+    });
+  CHECK_EXCEPTION(group.wait(), std::runtime_error);
+  EXPECT(count < 100);
+
+  // The group can be reused
+  const size_t failedCount = count;
+  group.run([&count]() { ++count; });
+  group.wait();
+  EXPECT_LONGS_EQUAL(failedCount + 1, count);
+}
+
+/* ************************************************************************* */
+TEST(TaskGroup, ParallelFor) {
+  for (size_t threads : {size_t(1), size_t(4)}) {
+    ConcurrencyScope scope(threads);
+
+    // Every index is visited exactly once
+    std::vector<std::atomic<size_t> > visits(1000);
+    for (auto& count : visits)
+      count = 0;
+    ParallelFor(10, 1000, 7, [&visits](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i)
+        ++visits[i];
+    });
+    for (size_t i = 0; i < 1000; ++i)
+      EXPECT_LONGS_EQUAL(i < 10 ? 0 : 1, visits[i]);
+
+    // Empty ranges do nothing
+    size_t calls = 0;
+    ParallelFor(5, 5, 1, [&calls](size_t, size_t) { ++calls; });
+    EXPECT_LONGS_EQUAL(0, calls);
+  }
+}
+
+/* ************************************************************************* */
+TEST(ThreadPool, setNrThreads) {
+  ThreadPool& pool = ThreadPool::Instance();
+  const size_t nrThreads = pool.nrThreads();
+  for (size_t threads : {size_t(1), size_t(4)}) {
+    pool.setNrThreads(threads);
+    EXPECT_LONGS_EQUAL(threads, pool.nrThreads());
+  }
+  pool.setNrThreads(nrThreads);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -18,12 +18,16 @@
 #include <CppUnitLite/TestHarness.h>
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/treeTraversal-inst.h>
+#include <gtsam/base/TaskGroup.h>
 
 #include <vector>
 #include <list>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/assign/std/list.hpp>
+#include <boost/assign/std/set.hpp>
+#include <mutex>
+#include <set>
 
 using boost::assign::operator+=;
 using namespace std;
@@ -35,6 +39,7 @@ struct TestNode {
   vector<shared_ptr> children;
   TestNode() : data(-1) {}
   TestNode(int data) : data(data) {}
+  int problemSize() const { return 1; }
 };
 
 struct TestForest {
@@ -126,6 +131,88 @@ TEST(treeTraversal, DepthFirst)
   EXPECT(assert_container_equality(postOrderExpected, postVisitor.visited));
 }
 
+/* ************************************************************************* */
+struct LockedPreOrderVisitor {
+  // Like PreOrderVisitor, but may be called from several threads at once.
+  std::mutex mutex;
+  PreOrderVisitor visitor;
+  int operator()(const TestNode::shared_ptr& node, int parentData) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return visitor(node, parentData);
+  }
+};
+
+/* ************************************************************************* */
+struct LockedPostOrderVisitor {
+  // Stores the nodes visited, and checks that the children of each node were visited first.
+  std::mutex mutex;
+  std::set<int> visited;
+  bool childrenFirst = true;
+  void operator()(const TestNode::shared_ptr& node, int myData) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const TestNode::shared_ptr& child : node->children)
+      if (!visited.count(child->data))
+        childrenFirst = false;
+    visited.insert(node->data);
+  }
+};
+
+/* ************************************************************************* */
+TEST(treeTraversal, DepthFirstParallel)
+{
+  // Get test forest
+  TestForest testForest = makeTestForest();
+
+  // Every node is visited once, and every subtree is split into tasks
+  LockedPreOrderVisitor preVisitor;
+  LockedPostOrderVisitor postVisitor;
+  int rootData = -1;
+  {
+    ConcurrencyScope scope(4);
+    treeTraversal::DepthFirstForestParallel(testForest, rootData, preVisitor, postVisitor, 0);
+  }
+
+  std::set<int> expected;
+  expected += 0, 1, 2, 3, 4;
+  EXPECT(preVisitor.visitor.parentsMatched);
+  EXPECT(assert_container_equality(expected, postVisitor.visited));
+  EXPECT(postVisitor.childrenFirst);
+}
+
+/* ************************************************************************* */
+TEST(treeTraversal, DepthFirstParallelAdaptive)
+{
+  // Get test forest
+  TestForest testForest = makeTestForest();
+
+  // Make tasks of all nodes but 3, whose subtree is processed in the task of node 0
+  std::mutex mutex;
+  std::set<int> tasks;
+  LockedPreOrderVisitor preVisitor;
+  LockedPostOrderVisitor postVisitor;
+  int rootData = -1;
+  {
+    ConcurrencyScope scope(4);
+    treeTraversal::DepthFirstForestParallelAdaptive(testForest, rootData, preVisitor, postVisitor,
+        [&](const TestNode& node) {
+          std::lock_guard<std::mutex> lock(mutex);
+          tasks.insert(node.data);
+          return node.data != 3;
+        });
+  }
+
+  std::set<int> expected;
+  expected += 0, 1, 2, 3, 4;
+  EXPECT(preVisitor.visitor.parentsMatched);
+  EXPECT(assert_container_equality(expected, postVisitor.visited));
+  EXPECT(postVisitor.childrenFirst);
+
+  // Node 4 is not asked whether it is worth a task, as its parent is not a task
+  std::set<int> expectedAsked;
+  expectedAsked += 0, 1, 2, 3;
+  EXPECT(assert_container_equality(expectedAsked, tasks));
+}
+
 /* ************************************************************************* */
 TEST(treeTraversal, CloneForest)
 {
@@ -154,13 +154,36 @@ template<class FOREST, typename DATA, typename VISITOR_PRE,
 void DepthFirstForestParallel(FOREST& forest, DATA& rootData,
     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
     int problemSizeThreshold = 10) {
-#ifdef GTSAM_USE_TBB
+#if defined(GTSAM_USE_TBB) || defined(GTSAM_USE_THREADPOOL)
   // Typedefs
   typedef typename FOREST::Node Node;
 
-  tbb::task::spawn_root_and_wait(
-      internal::CreateRootTask<Node>(forest.roots(), rootData, visitorPre,
-          visitorPost, problemSizeThreshold));
+  internal::processChildrenParallel<Node>(forest.roots(), rootData, visitorPre,
+      visitorPost, problemSizeThreshold, true);
+#else
+  DepthFirstForest(forest, rootData, visitorPre, visitorPost);
+#endif
+}
+
+/** Traverse a forest depth-first in parallel like DepthFirstForestParallel, but with the task
+ *  granularity decided per node rather than by a problem size threshold.
+ *  @param isTask \c isTask(node) is called on each node whose parent is processed in a task,
+ *         and returns whether the subtree of \c node is worth a task of its own, to run in
+ *         parallel with its siblings.  The subtrees of the other nodes are processed serially in
+ *         the task of their parent, so \c isTask should only return true for nodes whose
+ *         ancestors are tasks as well, e.g. by comparing a cost of the whole subtree to a
+ *         threshold.
+ *  See DepthFirstForestParallel for the other parameters. */
+template<class FOREST, typename DATA, typename VISITOR_PRE,
+    typename VISITOR_POST, typename IS_TASK>
+void DepthFirstForestParallelAdaptive(FOREST& forest, DATA& rootData,
+    VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, const IS_TASK& isTask) {
+#if defined(GTSAM_USE_TBB) || defined(GTSAM_USE_THREADPOOL)
+  // Typedefs
+  typedef typename FOREST::Node Node;
+
+  internal::processChildrenAdaptive<Node>(forest.roots(), rootData, visitorPre,
+      visitorPost, isTask);
 #else
   DepthFirstForest(forest, rootData, visitorPre, visitorPost);
 #endif
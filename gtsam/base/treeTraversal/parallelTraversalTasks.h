@@ -17,14 +17,12 @@
 #pragma once
 
 #include <gtsam/global_includes.h>
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/TaskGroup.h>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
-#ifdef GTSAM_USE_TBB
-#include <tbb/task.h>               // tbb::task, tbb::task_list
-#include <tbb/scalable_allocator.h> // tbb::scalable_allocator
-
 namespace gtsam {
 
   /** Internal functions used for traversing trees */
@@ -34,148 +32,133 @@ namespace gtsam {
 
       /* ************************************************************************* */
       template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
-      class PreOrderTask : public tbb::task
+      void processNodeRecursively(const boost::shared_ptr<NODE>& node, DATA& myData,
+                                  VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost)
       {
-      public:
-        const boost::shared_ptr<NODE>& treeNode;
-        boost::shared_ptr<DATA> myData;
-        VISITOR_PRE& visitorPre;
-        VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
-        bool makeNewTasks;
-
-        bool isPostOrderPhase;
-
-        PreOrderTask(const boost::shared_ptr<NODE>& treeNode, const boost::shared_ptr<DATA>& myData,
-                     VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold,
-                     bool makeNewTasks = true)
-            : treeNode(treeNode),
-              myData(myData),
-              visitorPre(visitorPre),
-              visitorPost(visitorPost),
-              problemSizeThreshold(problemSizeThreshold),
-              makeNewTasks(makeNewTasks),
-              isPostOrderPhase(false) {}
-
-        tbb::task* execute()
+        for(const boost::shared_ptr<NODE>& child: node->children)
         {
-          if(isPostOrderPhase)
-          {
-            // Run the post-order visitor since this task was recycled to run the post-order visitor
-            (void) visitorPost(treeNode, *myData);
-            return nullptr;
-          }
-          else
-          {
-            if(makeNewTasks)
-            {
-              if(!treeNode->children.empty())
-              {
-                // Allocate post-order task as a continuation
-                isPostOrderPhase = true;
-                recycle_as_continuation();
-
-                bool overThreshold = (treeNode->problemSize() >= problemSizeThreshold);
-
-                tbb::task* firstChild = 0;
-                tbb::task_list childTasks;
-                for(const boost::shared_ptr<NODE>& child: treeNode->children)
-                {
-                  // Process child in a subtask.  Important:  Run visitorPre before calling
-                  // allocate_child so that if visitorPre throws an exception, we will not have
-                  // allocated an extra child, this causes a TBB error.
-                  boost::shared_ptr<DATA> childData = boost::allocate_shared<DATA>(
-                      tbb::scalable_allocator<DATA>(), visitorPre(child, *myData));
-                  tbb::task* childTask =
-                      new (allocate_child()) PreOrderTask(child, childData, visitorPre, visitorPost,
-                                                          problemSizeThreshold, overThreshold);
-                  if (firstChild)
-                    childTasks.push_back(*childTask);
-                  else
-                    firstChild = childTask;
-                }
-
-                // If we have child tasks, start subtasks and wait for them to complete
-                set_ref_count((int)treeNode->children.size());
-                spawn(childTasks);
-                return firstChild;
-              }
-              else
-              {
-                // Run the post-order visitor in this task if we have no children
-                (void) visitorPost(treeNode, *myData);
-                return nullptr;
-              }
-            }
-            else
-            {
-              // Process this node and its children in this task
-              processNodeRecursively(treeNode, *myData);
-              return nullptr;
-            }
-          }
+          DATA childData = visitorPre(child, myData);
+          processNodeRecursively(child, childData, visitorPre, visitorPost);
+        }
+
+        // Run the post-order visitor
+        (void) visitorPost(node, myData);
+      }
+
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
+      void processNodeParallel(const boost::shared_ptr<NODE>& node, DATA& myData,
+                               VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                               int problemSizeThreshold, bool makeNewTasks);
+
+      /* ************************************************************************* */
+      /** Run the pre-order visitor on each of \c children, then process the children in
+       *  parallel tasks and wait for them.  The pre-order visitors run serially, in child order,
+       *  in the calling task, so they may append to \c parentData without synchronization. */
+      template<typename NODE, typename CHILDREN, typename DATA, typename VISITOR_PRE,
+               typename VISITOR_POST>
+      void processChildrenParallel(const CHILDREN& children, DATA& parentData,
+                                   VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                                   int problemSizeThreshold, bool makeNewTasks)
+      {
+        // Create data for all children before starting any task, so that if visitorPre throws,
+        // no task is left referring to it.
+        FastVector<boost::shared_ptr<DATA> > childData;
+        childData.reserve(children.size());
+        for(const boost::shared_ptr<NODE>& child: children)
+          childData.push_back(boost::make_shared<DATA>(visitorPre(child, parentData)));
+
+        // Process children in subtasks and wait for them to complete
+        TaskGroup group;
+        for(size_t i = 0; i < children.size(); ++i)
+        {
+          group.run([&, i]() {
+            processNodeParallel(children[i], *childData[i], visitorPre, visitorPost,
+                                problemSizeThreshold, makeNewTasks);
+          });
         }
+        group.wait();
+      }
 
-        void processNodeRecursively(const boost::shared_ptr<NODE>& node, DATA& myData)
+      /* ************************************************************************* */
+      /** Process the subtree of \c node, with the children in new tasks if \c makeNewTasks is
+       *  true, or all in the calling task otherwise.  Tasks are only created for the children of
+       *  nodes whose problem size is at least \c problemSizeThreshold. */
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
+      void processNodeParallel(const boost::shared_ptr<NODE>& node, DATA& myData,
+                               VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                               int problemSizeThreshold, bool makeNewTasks)
+      {
+        if(makeNewTasks)
         {
-          for(const boost::shared_ptr<NODE>& child: node->children)
+          if(!node->children.empty())
           {
-            DATA childData = visitorPre(child, myData);
-            processNodeRecursively(child, childData);
+            const bool overThreshold = (node->problemSize() >= problemSizeThreshold);
+            processChildrenParallel<NODE>(node->children, myData, visitorPre, visitorPost,
+                                          problemSizeThreshold, overThreshold);
           }
-
-          // Run the post-order visitor
+          // Run the post-order visitor once the children are done
           (void) visitorPost(node, myData);
         }
-      };
+        else
+        {
+          // Process this node and its children in this task
+          processNodeRecursively(node, myData, visitorPre, visitorPost);
+        }
+      }
 
       /* ************************************************************************* */
-      template<typename ROOTS, typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
-      class RootTask : public tbb::task
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST,
+               typename IS_TASK>
+      void processNodeAdaptive(const boost::shared_ptr<NODE>& node, DATA& myData,
+                               VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                               const IS_TASK& isTask);
+
+      /** Run the pre-order visitor on each of \c children, then process the children for which
+       *  \c isTask is true in parallel tasks, and the others serially in the calling task. */
+      template<typename NODE, typename CHILDREN, typename DATA, typename VISITOR_PRE,
+               typename VISITOR_POST, typename IS_TASK>
+      void processChildrenAdaptive(const CHILDREN& children, DATA& parentData,
+                                   VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                                   const IS_TASK& isTask)
       {
-      public:
-        const ROOTS& roots;
-        DATA& myData;
-        VISITOR_PRE& visitorPre;
-        VISITOR_POST& visitorPost;
-        int problemSizeThreshold;
-        RootTask(const ROOTS& roots, DATA& myData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
-          int problemSizeThreshold) :
-          roots(roots), myData(myData), visitorPre(visitorPre), visitorPost(visitorPost),
-          problemSizeThreshold(problemSizeThreshold) {}
-
-        tbb::task* execute()
+        FastVector<boost::shared_ptr<DATA> > childData;
+        childData.reserve(children.size());
+        for(const boost::shared_ptr<NODE>& child: children)
+          childData.push_back(boost::make_shared<DATA>(visitorPre(child, parentData)));
+
+        // Start the tasks first, so that they run while we process the small subtrees
+        TaskGroup group;
+        for(size_t i = 0; i < children.size(); ++i)
         {
-          typedef PreOrderTask<NODE, DATA, VISITOR_PRE, VISITOR_POST> PreOrderTask;
-          // Create data and tasks for our children
-          tbb::task_list tasks;
-          for(const boost::shared_ptr<NODE>& root: roots)
+          if(isTask(*children[i]))
           {
-            boost::shared_ptr<DATA> rootData = boost::allocate_shared<DATA>(tbb::scalable_allocator<DATA>(), visitorPre(root, myData));
-            tasks.push_back(*new(allocate_child())
-              PreOrderTask(root, rootData, visitorPre, visitorPost, problemSizeThreshold));
+            group.run([&, i]() {
+              processNodeAdaptive(children[i], *childData[i], visitorPre, visitorPost, isTask);
+            });
           }
-          // Set TBB ref count
-          set_ref_count(1 + (int) roots.size());
-          // Spawn tasks
-          spawn_and_wait_for_all(tasks);
-          // Return nullptr
-          return nullptr;
         }
-      };
+        for(size_t i = 0; i < children.size(); ++i)
+        {
+          if(!isTask(*children[i]))
+            processNodeRecursively(children[i], *childData[i], visitorPre, visitorPost);
+        }
+        group.wait();
+      }
 
-      template<typename NODE, typename ROOTS, typename DATA, typename VISITOR_PRE, typename VISITOR_POST>
-      RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST>&
-        CreateRootTask(const ROOTS& roots, DATA& rootData, VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost, int problemSizeThreshold)
+      /* ************************************************************************* */
+      template<typename NODE, typename DATA, typename VISITOR_PRE, typename VISITOR_POST,
+               typename IS_TASK>
+      void processNodeAdaptive(const boost::shared_ptr<NODE>& node, DATA& myData,
+                               VISITOR_PRE& visitorPre, VISITOR_POST& visitorPost,
+                               const IS_TASK& isTask)
       {
-          typedef RootTask<ROOTS, NODE, DATA, VISITOR_PRE, VISITOR_POST> RootTask;
-          return *new(tbb::task::allocate_root()) RootTask(roots, rootData, visitorPre, visitorPost, problemSizeThreshold);
-        }
+        if(!node->children.empty())
+          processChildrenAdaptive<NODE>(node->children, myData, visitorPre, visitorPost, isTask);
+        (void) visitorPost(node, myData);
+      }
 
     }
 
   }
 
 }
-
-#endif
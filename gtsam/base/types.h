@@ -145,15 +145,15 @@ namespace gtsam {
 #  pragma clang diagnostic ignored "-Wunused-private-field" // Clang complains that previousOpenMPThreads is unused in the #else case below
 #endif
 
-  /// An object whose scope defines a block where TBB and OpenMP parallelism are mixed.  In such a
-  /// block, we use default threads for TBB, and p/2 threads for OpenMP.  If GTSAM is not compiled to
-  /// use both TBB and OpenMP, this has no effect.
+  /// An object whose scope defines a block where TBB (or the built-in thread pool) and OpenMP
+  /// parallelism are mixed.  In such a block, we use default threads for TBB, and p/2 threads for
+  /// OpenMP.  If GTSAM is not compiled to use both task parallelism and OpenMP, this has no effect.
   class TbbOpenMPMixedScope
   {
     int previousOpenMPThreads;
 
   public:
-#if defined GTSAM_USE_TBB && defined GTSAM_USE_EIGEN_MKL_OPENMP
+#if (defined GTSAM_USE_TBB || defined GTSAM_USE_THREADPOOL) && defined GTSAM_USE_EIGEN_MKL_OPENMP
     TbbOpenMPMixedScope() :
       previousOpenMPThreads(omp_get_num_threads())
     {
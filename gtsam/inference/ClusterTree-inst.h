@@ -14,6 +14,12 @@
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
+#include <gtsam/base/TaskGroup.h>
+#include <gtsam/base/cholesky.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
 
 namespace gtsam {
 
@@ -152,13 +158,19 @@ struct EliminationData {
   class EliminationPostOrderVisitor {
     const typename CLUSTERTREE::Eliminate& eliminationFunction_;
     typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex_;
+    const double parallelCholeskyCost_;  // Cliques that cost at least this use parallel Cholesky
+#ifndef GTSAM_USE_TBB
+    std::mutex nodesIndexMutex_;  // Without TBB, the nodes index is not a concurrent container
+#endif
 
   public:
     // Construct functor
     EliminationPostOrderVisitor(
         const typename CLUSTERTREE::Eliminate& eliminationFunction,
-        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex) :
-        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex) {
+        typename CLUSTERTREE::BayesTreeType::Nodes& nodesIndex,
+        double parallelCholeskyCost = std::numeric_limits<double>::infinity()) :
+        eliminationFunction_(eliminationFunction), nodesIndex_(nodesIndex),
+        parallelCholeskyCost_(parallelCholeskyCost) {
     }
 
     // Function that does the HEAVY lifting
@@ -181,6 +193,10 @@ struct EliminationData {
         }
       }
 
+      // Let the dense factorization of the few cliques that are too large for a single thread
+      // use parallel tasks
+      CholeskyParallelScope parallelScope(node->cost() >= parallelCholeskyCost_);
+
       // >>>>>>>>>>>>>> Do dense elimination step >>>>>>>>>>>>>>>>>>>>>>>>>>>>>
       auto eliminationResult = eliminationFunction_(gatheredFactors, node->orderedFrontalKeys);
       // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -192,8 +208,13 @@ struct EliminationData {
       // Fill nodes index - we do this here instead of calling insertRoot at the end to avoid
       // putting orphan subtrees in the index - they'll already be in the index of the ISAM2
       // object they're added to.
-      for (const Key& j: myData.bayesTreeNode->conditional()->frontals())
-        nodesIndex_.insert(std::make_pair(j, myData.bayesTreeNode));
+      {
+#ifndef GTSAM_USE_TBB
+        std::lock_guard<std::mutex> lock(nodesIndexMutex_);
+#endif
+        for (const Key& j: myData.bayesTreeNode->conditional()->frontals())
+          nodesIndex_.insert(std::make_pair(j, myData.bayesTreeNode));
+      }
 
       // Store remaining factor in parent's gathered factors
       if (!eliminationResult.second->empty())
@@ -228,8 +249,34 @@ EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function)
   typedef EliminationData<This> Data;
   Data rootsContainer(0, this->nrRoots());
 
-  typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_);
-  {
+  // Estimated cost of the whole elimination, if the clusters have cost estimates (see
+  // JunctionTree)
+  double totalCost = 0.0;
+  for (const auto& root : this->roots())
+    totalCost += root->subtreeCost();
+
+  if (totalCost > 0.0) {
+    // Make tasks of subtrees that are worth several times the task overhead, and small enough to
+    // give each thread a few tasks to balance the load.  Cliques that cost a large part of what
+    // each thread should do, typically near the root, split their dense factorization instead.
+    static const double minTaskCost = 100.0;
+    static const double minParallelCholeskyCost = 1e5;
+    const size_t nrThreads = TaskGroup::MaxConcurrency();
+    const double taskCost = std::max(minTaskCost, totalCost / (8 * nrThreads));
+    const double parallelCholeskyCost =
+        nrThreads > 1 ? std::max(minParallelCholeskyCost, totalCost / (2 * nrThreads))
+                      : std::numeric_limits<double>::infinity();
+
+    typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_,
+                                                           parallelCholeskyCost);
+    TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
+    treeTraversal::DepthFirstForestParallelAdaptive(
+        *this, rootsContainer, Data::EliminationPreOrderVisitor, visitorPost,
+        [taskCost](const typename ClusterTree<GRAPH>::Cluster& cluster) {
+          return cluster.subtreeCost() >= taskCost;
+        });
+  } else {
+    typename Data::EliminationPostOrderVisitor visitorPost(function, result->nodes_);
     TbbOpenMPMixedScope threadLimiter;  // Limits OpenMP threads since we're mixing TBB and OpenMP
     treeTraversal::DepthFirstForestParallel(*this, rootsContainer, Data::EliminationPreOrderVisitor,
                                             visitorPost, 10);
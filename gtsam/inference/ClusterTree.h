@@ -15,6 +15,28 @@
 
 namespace gtsam {
 
+/**
+ * Estimated number of flops to eliminate a clique with frontal variables of total dimension
+ * \c frontalDim and separator variables of total dimension \c separatorDim by partial Cholesky:
+ * factoring the frontal block (f^3/3), solving for the separator rows of the conditional
+ * (f^2 s), and updating the separator block (f s^2).  This is used to balance parallel
+ * elimination.
+ */
+inline double EliminationCost(size_t frontalDim, size_t separatorDim) {
+  const double f = double(frontalDim), s = double(separatorDim);
+  return f * f * f / 3.0 + f * f * s + f * s * s;
+}
+
+/**
+ * Dimension of the variable \c variable of \c factor, for EliminationCost.  Factors without
+ * dimensions, e.g. symbolic or discrete ones, count every variable as one; GaussianFactor
+ * overloads this with the dimensions of its blocks.
+ */
+template<class FACTOR>
+size_t EliminationVariableDim(const FACTOR& factor, typename FACTOR::const_iterator variable) {
+  return 1;
+}
+
 /**
  * A cluster-tree is associated with a factor graph and is defined as in Koller-Friedman:
  * each node k represents a subset \f$ C_k \sub X \f$, and the tree is family preserving, in that
@@ -44,7 +66,10 @@ class ClusterTree {
 
     int problemSize_;
 
-    Cluster() : problemSize_(0) {}
+    double cost_;         ///< Estimated cost of eliminating this cluster, see EliminationCost
+    double subtreeCost_;  ///< Estimated cost of eliminating this cluster and its descendants
+
+    Cluster() : problemSize_(0), cost_(0.0), subtreeCost_(0.0) {}
 
     virtual ~Cluster() {}
 
@@ -55,7 +80,7 @@ class ClusterTree {
     /// Construct from factors associated with a single key
     template <class CONTAINER>
     Cluster(Key key, const CONTAINER& factorsToAdd)
-        : problemSize_(0) {
+        : problemSize_(0), cost_(0.0), subtreeCost_(0.0) {
       addFactors(key, factorsToAdd);
     }
 
@@ -89,6 +114,16 @@ class ClusterTree {
       return problemSize_;
     }
 
+    /// Estimated cost of eliminating this cluster, or 0 if it was not estimated
+    double cost() const {
+      return cost_;
+    }
+
+    /// Estimated cost of eliminating this cluster and all of its descendants
+    double subtreeCost() const {
+      return subtreeCost_;
+    }
+
     /// print this node
     virtual void print(const std::string& s = "",
                        const KeyFormatter& keyFormatter = DefaultKeyFormatter) const;
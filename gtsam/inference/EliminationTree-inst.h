@@ -38,24 +38,37 @@ namespace gtsam {
     const Eliminate& function, const FastVector<sharedFactor>& childrenResults) const
   {
     // This function eliminates one node (Node::eliminate) - see below eliminate for the whole tree.
+    std::pair<sharedConditional, sharedFactor> eliminationResult =
+      eliminate(function, childrenResults);
 
-    assert(childrenResults.size() == children.size());
+    // Add conditional to BayesNet
+    output->push_back(eliminationResult.first);
+
+    // Return result
+    return eliminationResult.second;
+  }
+
+  /* ************************************************************************* */
+  template<class BAYESNET, class GRAPH>
+  std::pair<typename EliminationTree<BAYESNET,GRAPH>::sharedConditional,
+            typename EliminationTree<BAYESNET,GRAPH>::sharedFactor>
+    EliminationTree<BAYESNET,GRAPH>::Node::eliminate(
+    const Eliminate& function, const FastVector<sharedFactor>& childrenResults) const
+  {
+    assert(childrenResults.size() <= children.size());
 
-    // Gather factors
+    // Gather factors, children that were eliminated completely leave no factor
     FactorGraphType gatheredFactors;
     gatheredFactors.reserve(factors.size() + children.size());
     gatheredFactors.push_back(factors.begin(), factors.end());
-    gatheredFactors.push_back(childrenResults.begin(), childrenResults.end());
+    for (const sharedFactor& childFactor : childrenResults)
+      if (childFactor)
+        gatheredFactors.push_back(childFactor);
 
     // Do dense elimination step
     KeyVector keyAsVector(1); keyAsVector[0] = key;
     auto eliminationResult = function(gatheredFactors, Ordering(keyAsVector));
-
-    // Add conditional to BayesNet
-    output->push_back(eliminationResult.first);
-
-    // Return result
-    return eliminationResult.second;
+    return std::make_pair(eliminationResult.first, eliminationResult.second);
   }
 
   /* ************************************************************************* */
@@ -124,6 +137,7 @@ namespace gtsam {
               // Now that we found the root, hook up parent and child pointers in the nodes.
               parents[r] = j;
               node->children.push_back(nodes[r]);
+              node->problemSize_ += nodes[r]->problemSize_;
             }
           } else {
             // Add the factor to the current node since we are at the first variable in this factor.
@@ -70,10 +70,20 @@ namespace gtsam {
       Key key; ///< key associated with root
       Factors factors; ///< factors associated with root
       Children children; ///< sub-trees
+      int problemSize_; ///< number of variables in this sub-tree
+
+      Node() : problemSize_(1) {}
+
+      int problemSize() const { return problemSize_; }
 
       sharedFactor eliminate(const boost::shared_ptr<BayesNetType>& output,
         const Eliminate& function, const FastVector<sharedFactor>& childrenFactors) const;
 
+      /** Eliminate this node, given the remaining factors of its children, some of which may be
+       *  null. Returns the conditional and the remaining factor, does not modify the node. */
+      std::pair<sharedConditional, sharedFactor> eliminate(
+        const Eliminate& function, const FastVector<sharedFactor>& childrenFactors) const;
+
       void print(const std::string& str, const KeyFormatter& keyFormatter) const;
     };
 
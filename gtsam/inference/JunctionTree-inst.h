@@ -24,6 +24,7 @@
 #include <gtsam/inference/ClusterTree-inst.h>
 #include <gtsam/symbolic/SymbolicConditional.h>
 #include <gtsam/symbolic/SymbolicFactor-inst.h>
+#include <gtsam/base/FastMap.h>
 
 namespace gtsam {
 
@@ -33,6 +34,7 @@ struct ConstructorTraversalData {
   typedef typename JunctionTree<BAYESTREE, GRAPH>::sharedNode sharedNode;
 
   ConstructorTraversalData* const parentData;
+  FastMap<Key, size_t>* dims; // Dimensions of the variables seen so far, shared by all nodes
   sharedNode myJTNode;
   FastVector<SymbolicConditional::shared_ptr> childSymbolicConditionals;
   FastVector<SymbolicFactor::shared_ptr> childSymbolicFactors;
@@ -42,7 +44,7 @@ struct ConstructorTraversalData {
   };
 
   ConstructorTraversalData(ConstructorTraversalData* _parentData) :
-      parentData(_parentData) {
+      parentData(_parentData), dims(_parentData ? _parentData->dims : 0) {
   }
 
   // Pre-order visitor function
@@ -71,6 +73,14 @@ struct ConstructorTraversalData {
     // eliminating the current node did not introduce any parents beyond those
     // already in the child->
 
+    // Record the dimensions of the variables of our factors.  The frontal and separator
+    // variables of a clique all appear in the factors of its subtree, which were recorded
+    // before.
+    for (const auto& factor : ETreeNode->factors)
+      if (factor)
+        for (auto key = factor->begin(); key != factor->end(); ++key)
+          myData.dims->emplace(*key, EliminationVariableDim(*factor, key));
+
     // Do symbolic elimination for this node
     SymbolicFactors symbolicFactors;
     symbolicFactors.reserve(
@@ -117,6 +127,18 @@ struct ConstructorTraversalData {
 
     // now really merge
     node->mergeChildren(merge);
+
+    // Estimate the cost of eliminating the clique, and of its whole subtree.  The separator of
+    // the clique is the set of parents of its last frontal variable, i.e. of this node.
+    size_t frontalDim = 0, separatorDim = 0;
+    for (Key key : node->orderedFrontalKeys)
+      frontalDim += myData.dims->at(key);
+    for (Key key : myConditional->parents())
+      separatorDim += myData.dims->at(key);
+    node->cost_ = EliminationCost(frontalDim, separatorDim);
+    node->subtreeCost_ = node->cost_;
+    for (const sharedNode& child : node->children)
+      node->subtreeCost_ += child->subtreeCost_;
   }
 };
 
@@ -137,7 +159,9 @@ JunctionTree<BAYESTREE, GRAPH>::JunctionTree(
   // as we go.  Gather the created junction tree roots in a dummy Node.
   typedef typename EliminationTree<ETREE_BAYESNET, ETREE_GRAPH>::Node ETreeNode;
   typedef ConstructorTraversalData<BAYESTREE, GRAPH, ETreeNode> Data;
+  FastMap<Key, size_t> dims;
   Data rootData(0);
+  rootData.dims = &dims;
   rootData.myJTNode = boost::make_shared<typename Base::Node>(); // Make a dummy node to gather
                                                                  // the junction tree roots
   treeTraversal::DepthFirstForest(eliminationTree, rootData,
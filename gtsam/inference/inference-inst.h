@@ -25,6 +25,7 @@
 
 #include <gtsam/base/treeTraversal-inst.h>
 #include <gtsam/base/FastVector.h>
+#include <gtsam/base/types.h>
 
 namespace gtsam {
   namespace inference {
@@ -34,9 +35,23 @@ namespace gtsam {
       template<class TREE>
       struct EliminationData {
         EliminationData* const parentData;
+        size_t myIndexInParent; // Slot for our remaining factor in the parent's childFactors
+        size_t nextPosition; // Output position of the first conditional of the next child subtree
+        size_t myPosition; // Output position of our conditional, in depth-first post-order
         FastVector<typename TREE::sharedFactor> childFactors;
-        EliminationData(EliminationData* _parentData, size_t nChildren) :
-          parentData(_parentData) { childFactors.reserve(nChildren); }
+        EliminationData(EliminationData* _parentData, size_t nChildren, size_t problemSize) :
+          parentData(_parentData), myIndexInParent(0), nextPosition(0), myPosition(0) {
+          childFactors.reserve(nChildren);
+          if (parentData) {
+            // Claim a slot and a range of output positions in sibling order, which is the same
+            // whether the siblings are then eliminated serially or in parallel.
+            myIndexInParent = parentData->childFactors.size();
+            parentData->childFactors.push_back(typename TREE::sharedFactor());
+            nextPosition = parentData->nextPosition;
+            parentData->nextPosition += problemSize;
+            myPosition = nextPosition + problemSize - 1;
+          }
+        }
       };
 
       /* ************************************************************************* */
@@ -46,47 +61,74 @@ namespace gtsam {
       {
         // This function is called before visiting the children.  Here, we create this node's data,
         // which includes a pointer to the parent data and space for the factors of the children.
-        return EliminationData<TREE>(&parentData, node->children.size());
+        return EliminationData<TREE>(&parentData, node->children.size(), node->problemSize());
       }
 
       /* ************************************************************************* */
-      template<class TREE, class RESULT>
+      template<class TREE>
       struct EliminationPostOrderVisitor
       {
-        RESULT& result;
+        FastVector<typename TREE::sharedConditional>& conditionals;
         const typename TREE::Eliminate& eliminationFunction;
-        EliminationPostOrderVisitor(RESULT& result, const typename TREE::Eliminate& eliminationFunction) :
-          result(result), eliminationFunction(eliminationFunction) {}
+        EliminationPostOrderVisitor(FastVector<typename TREE::sharedConditional>& conditionals,
+          const typename TREE::Eliminate& eliminationFunction) :
+          conditionals(conditionals), eliminationFunction(eliminationFunction) {}
         void operator()(const typename TREE::sharedNode& node, EliminationData<TREE>& myData)
         {
-          // Call eliminate on the node and add the result to the parent's gathered factors
-          typename TREE::sharedFactor childFactor = node->eliminate(result, eliminationFunction, myData.childFactors);
+          // Call eliminate on the node, store the conditional at its position, and put the
+          // remaining factor in our slot in the parent's gathered factors
+          auto eliminationResult = node->eliminate(eliminationFunction, myData.childFactors);
+          conditionals[myData.myPosition] = eliminationResult.first;
+          const typename TREE::sharedFactor& childFactor = eliminationResult.second;
           if(childFactor && !childFactor->empty())
-            myData.parentData->childFactors.push_back(childFactor);
+            myData.parentData->childFactors[myData.myIndexInParent] = childFactor;
         }
       };
     }
 
     /* ************************************************************************* */
-    /** Eliminate an elimination tree or a Bayes tree (used internally).  Requires
-     *  TREE::BayesNetType, TREE::FactorGraphType, TREE::sharedConditional, TREE::sharedFactor,
-     *  TREE::Node, TREE::sharedNode, TREE::Node::factors, TREE::Node::children. */
+    /** Eliminate an elimination tree (used internally).  Requires TREE::BayesNetType,
+     *  TREE::FactorGraphType, TREE::sharedConditional, TREE::sharedFactor, TREE::Node,
+     *  TREE::sharedNode, TREE::Node::children, TREE::Node::eliminate(function, childFactors),
+     *  and TREE::Node::problemSize() returning the number of nodes in the subtree.
+     *
+     *  Independent subtrees are eliminated in parallel when GTSAM is built with TBB.  The
+     *  conditionals are added to \c result in depth-first post-order, and the child factors are
+     *  gathered in child order, regardless of the order in which the subtrees finish, so the
+     *  result is the same as that of a single-threaded traversal. */
     template<class TREE, class RESULT>
     FastVector<typename TREE::sharedFactor>
     EliminateTree(RESULT& result, const TREE& tree, const typename TREE::Eliminate& function)
     {
       // Do elimination using a depth-first traversal.  During the pre-order visit (see
       // eliminationPreOrderVisitor), we store a pointer to the parent data (where we'll put the
-      // remaining factor) and reserve a vector of factors to store the children elimination
-      // results.  During the post-order visit (see eliminationPostOrderVisitor), we call dense
-      // elimination (using the gathered child factors) and store the result in the parent's
-      // gathered factors.
-      EliminationData<TREE> rootData(0, tree.roots().size());
-      EliminationPostOrderVisitor<TREE,RESULT> visitorPost(result, function);
-      treeTraversal::DepthFirstForest(tree, rootData, eliminationPreOrderVisitor<TREE>, visitorPost);
+      // remaining factor) and reserve a slot in the parent's gathered factors and a position for
+      // our conditional.  During the post-order visit (see EliminationPostOrderVisitor), we call
+      // dense elimination (using the gathered child factors) and store the results.
+      size_t nrNodes = 0;
+      for (const typename TREE::sharedNode& root : tree.roots())
+        nrNodes += root->problemSize();
+      FastVector<typename TREE::sharedConditional> conditionals(nrNodes);
+
+      EliminationData<TREE> rootData(0, tree.roots().size(), 0);
+      EliminationPostOrderVisitor<TREE> visitorPost(conditionals, function);
+      {
+        TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+        treeTraversal::DepthFirstForestParallel(tree, rootData, eliminationPreOrderVisitor<TREE>,
+                                                visitorPost, 10);
+      }
+
+      // Add conditionals in elimination order
+      for (const typename TREE::sharedConditional& conditional : conditionals)
+        result->push_back(conditional);
 
       // Return remaining factors
-      return rootData.childFactors;
+      FastVector<typename TREE::sharedFactor> remainingFactors;
+      remainingFactors.reserve(rootData.childFactors.size());
+      for (const typename TREE::sharedFactor& factor : rootData.childFactors)
+        if (factor)
+          remainingFactors.push_back(factor);
+      return remainingFactors;
     }
 
   }
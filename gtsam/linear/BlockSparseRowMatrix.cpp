@@ -0,0 +1,199 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockSparseRowMatrix.cpp
+ * @brief   Whitened Jacobian of a GaussianFactorGraph in block sparse row form
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/BlockSparseRowMatrix.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/TaskGroup.h>
+#include <gtsam/base/timing.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+// Block rows and block columns per parallel task in the products
+const size_t kGrainSize = 256;
+
+typedef Eigen::Map<const Matrix> ConstMatrixMap;
+}
+
+/* ************************************************************************* */
+BlockSparseRowMatrix::BlockSparseRowMatrix(const GaussianFactorGraph& gfg,
+                                           const KeyInfo& keyInfo)
+    : BlockSparseRowMatrix() {
+  gttic(BlockSparseRowMatrix);
+  // Scalar layout of the columns, by position in the ordering
+  const size_t nrVariables = keyInfo.size();
+  columnStarts_.assign(nrVariables + 1, 0);
+  for (const KeyInfo::value_type& key_info : keyInfo)
+    columnStarts_[key_info.second.index] = key_info.second.start;
+  columnStarts_[nrVariables] = keyInfo.numCols();
+
+  // Split the graph, and count rows and entries
+  vector<JacobianFactor::shared_ptr> jacobians;
+  size_t nrEntries = 0;
+  DenseIndex nrRows = 0;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor) continue;
+    auto jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor);
+    if (!jacobian) {
+      otherFactors_.push_back(factor);
+      continue;
+    }
+    if (jacobian->rows() == 0) continue;
+    jacobians.push_back(jacobian);
+    nrRows += jacobian->rows();
+    nrEntries += jacobian->rows() * jacobian->getA().cols();
+  }
+
+  // Copy the whitened blocks and right-hand sides
+  rowStarts_.reserve(jacobians.size() + 1);
+  rowBlockStarts_.reserve(jacobians.size() + 1);
+  values_.resize(nrEntries);
+  rhs_.resize(nrRows);
+  vector<size_t> blocksPerColumn(nrVariables, 0), blockVariables;
+  size_t offset = 0;
+  for (const JacobianFactor::shared_ptr& jacobian : jacobians) {
+    const DenseIndex rows = jacobian->rows(), row = rowStarts_.back();
+    Matrix A = jacobian->getA();
+    Vector b = jacobian->getb();
+    if (const SharedDiagonal& model = jacobian->get_model()) {
+      A = model->Whiten(A);
+      b = model->whiten(b);
+    }
+    rhs_.segment(row, rows) = b;
+
+    DenseIndex column = 0;
+    for (auto key = jacobian->begin(); key != jacobian->end(); ++key) {
+      const auto key_info = keyInfo.find(*key);
+      if (key_info == keyInfo.end())
+        throw invalid_argument(
+            "BlockSparseRowMatrix: the KeyInfo does not contain all keys");
+      const DenseIndex cols = jacobian->getDim(key);
+      const size_t variable = key_info->second.index;
+      Eigen::Map<Matrix>(values_.data() + offset, rows, cols) =
+          A.middleCols(column, cols);
+      blocks_.push_back({nrBlockRows(), columnStarts_[variable], cols, offset});
+      blockVariables.push_back(variable);
+      ++blocksPerColumn[variable];
+      offset += rows * cols;
+      column += cols;
+    }
+    rowStarts_.push_back(row + rows);
+    rowBlockStarts_.push_back(blocks_.size());
+  }
+
+  // Index the blocks of each variable
+  columnBlockStarts_.assign(nrVariables + 1, 0);
+  for (size_t variable = 0; variable < nrVariables; ++variable)
+    columnBlockStarts_[variable + 1] =
+        columnBlockStarts_[variable] + blocksPerColumn[variable];
+  columnBlocks_.resize(blocks_.size());
+  vector<size_t> next(columnBlockStarts_.begin(), columnBlockStarts_.end() - 1);
+  for (size_t k = 0; k < blocks_.size(); ++k)
+    columnBlocks_[next[blockVariables[k]]++] = k;
+}
+
+/* ************************************************************************* */
+void BlockSparseRowMatrix::multiply(const Vector& x, Vector& y) const {
+  ParallelFor(0, nrBlockRows(), kGrainSize, [&](size_t first, size_t last) {
+    for (size_t r = first; r < last; ++r) {
+      const DenseIndex rows = rowStarts_[r + 1] - rowStarts_[r];
+      auto yr = y.segment(rowStarts_[r], rows);
+      yr.setZero();
+      for (size_t k = rowBlockStarts_[r]; k < rowBlockStarts_[r + 1]; ++k) {
+        const Block& block = blocks_[k];
+        yr.noalias() +=
+            ConstMatrixMap(values_.data() + block.offset, rows, block.cols) *
+            x.segment(block.column, block.cols);
+      }
+    }
+  });
+}
+
+/* ************************************************************************* */
+void BlockSparseRowMatrix::transposeMultiply(const Vector& y, Vector& x) const {
+  const size_t nrVariables = columnStarts_.size() - 1;
+  ParallelFor(0, nrVariables, kGrainSize, [&](size_t first, size_t last) {
+    for (size_t j = first; j < last; ++j) {
+      auto xj = x.segment(columnStarts_[j],
+                          columnStarts_[j + 1] - columnStarts_[j]);
+      xj.setZero();
+      for (size_t i = columnBlockStarts_[j]; i < columnBlockStarts_[j + 1];
+           ++i) {
+        const Block& block = blocks_[columnBlocks_[i]];
+        const DenseIndex row = rowStarts_[block.rowBlock],
+                         rows = rowStarts_[block.rowBlock + 1] - row;
+        xj.noalias() += ConstMatrixMap(values_.data() + block.offset, rows,
+                                       block.cols).transpose() *
+                        y.segment(row, rows);
+      }
+    }
+  });
+}
+
+/* ************************************************************************* */
+void BlockSparseRowMatrix::multiplyHessian(const Vector& x, Vector& y,
+                                           const KeyInfo& keyInfo) const {
+  Ax_.resize(rows());
+  multiply(x, Ax_);
+  y.resize(cols());
+  transposeMultiply(Ax_, y);
+
+  if (!otherFactors_.empty()) {
+    VectorValues Hx = keyInfo.x0();
+    otherFactors_.multiplyHessianAdd(1.0, buildVectorValues(x, keyInfo), Hx);
+    y += Hx.vector(keyInfo.ordering());
+  }
+}
+
+/* ************************************************************************* */
+Vector BlockSparseRowMatrix::negativeGradientAtZero(
+    const KeyInfo& keyInfo) const {
+  Vector g(cols());
+  transposeMultiply(rhs_, g);
+  if (!otherFactors_.empty()) {
+    for (const VectorValues::KeyValuePair& key_gradient :
+         otherFactors_.gradientAtZero()) {
+      const KeyInfoEntry& entry = keyInfo.at(key_gradient.first);
+      g.segment(entry.start, entry.dim) -= key_gradient.second;
+    }
+  }
+  return g;
+}
+
+/* ************************************************************************* */
+Matrix BlockSparseRowMatrix::augmentedMatrix() const {
+  Matrix Ab = Matrix::Zero(rows(), cols() + 1);
+  for (size_t r = 0; r < nrBlockRows(); ++r) {
+    const DenseIndex rows = rowStarts_[r + 1] - rowStarts_[r];
+    for (size_t k = rowBlockStarts_[r]; k < rowBlockStarts_[r + 1]; ++k) {
+      const Block& block = blocks_[k];
+      Ab.block(rowStarts_[r], block.column, rows, block.cols) =
+          ConstMatrixMap(values_.data() + block.offset, rows, block.cols);
+    }
+  }
+  Ab.col(cols()) = rhs_;
+  return Ab;
+}
+
+} // \namespace gtsam
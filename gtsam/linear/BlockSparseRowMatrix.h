@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    BlockSparseRowMatrix.h
+ * @brief   Whitened Jacobian of a GaussianFactorGraph in block sparse row form
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/Vector.h>
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gtsam {
+
+class KeyInfo;
+
+/**
+ * The whitened Jacobian A of the JacobianFactors in a GaussianFactorGraph,
+ * assembled once into a block sparse row (BSR) matrix. This is the operator
+ * behind the BSR kernel of ConjugateGradientParameters.
+ *
+ * Each factor is a block row, and each of its keys a dense block in that row.
+ * The blocks are stored column-major, one after the other in a single
+ * contiguous array, so that A*x and A'*y are sequences of small dense
+ * products on contiguous memory, which Eigen vectorizes. Block widths are the
+ * variable dimensions, so that a problem with a few variable types (e.g. 6D
+ * cameras and 3D points) has blocks of a few fixed sizes. The columns follow
+ * the scalar layout of a KeyInfo, which is the layout of the vectors of
+ * PCGSolver. A column index of the blocks in each column makes A'*y a gather
+ * per variable, so both products run in parallel without write conflicts.
+ *
+ * Factors that are not JacobianFactors (e.g. HessianFactors) have no rows to
+ * store; they are kept in otherFactors(), and multiplyHessianAdd() applies
+ * them through the GaussianFactorGraph interface.
+ */
+class GTSAM_EXPORT BlockSparseRowMatrix {
+ public:
+  typedef boost::shared_ptr<BlockSparseRowMatrix> shared_ptr;
+
+  /// A dense block of A
+  struct Block {
+    size_t rowBlock;    ///< Block row, i.e. the factor, of this block
+    DenseIndex column;  ///< Scalar column of the first entry
+    DenseIndex cols;    ///< Number of columns, the variable dimension
+    size_t offset;      ///< Offset of the column-major entries in values()
+  };
+
+ private:
+  std::vector<DenseIndex> rowStarts_;   ///< Scalar row of each block row, plus end
+  std::vector<size_t> rowBlockStarts_;  ///< First block of each block row, plus end
+  std::vector<Block> blocks_;           ///< Blocks, in block row order
+  std::vector<DenseIndex> columnStarts_;   ///< Scalar column of each variable, plus end
+  std::vector<size_t> columnBlockStarts_;  ///< First entry in columnBlocks_ per variable, plus end
+  std::vector<size_t> columnBlocks_;    ///< Blocks of each block column
+  Vector values_;                       ///< Entries of all blocks
+  Vector rhs_;                          ///< Whitened right-hand side b
+  GaussianFactorGraph otherFactors_;    ///< Factors that are not JacobianFactors
+  mutable Vector Ax_;                   ///< Scratch for A*x in multiplyHessian
+
+ public:
+  /// Create an empty matrix
+  BlockSparseRowMatrix() : rowStarts_(1, 0), rowBlockStarts_(1, 0),
+      columnStarts_(1, 0), columnBlockStarts_(1, 0) {}
+
+  /**
+   * Assemble the whitened Jacobian of \c gfg, with the columns laid out as in
+   * \c keyInfo, which must contain all keys of the graph.
+   */
+  BlockSparseRowMatrix(const GaussianFactorGraph& gfg, const KeyInfo& keyInfo);
+
+  /// Number of scalar rows
+  DenseIndex rows() const { return rowStarts_.back(); }
+
+  /// Number of scalar columns
+  DenseIndex cols() const { return columnStarts_.back(); }
+
+  /// Number of block rows
+  size_t nrBlockRows() const { return rowStarts_.size() - 1; }
+
+  /// The blocks, in block row order
+  const std::vector<Block>& blocks() const { return blocks_; }
+
+  /// The entries of all blocks
+  const Vector& values() const { return values_; }
+
+  /// The whitened right-hand side b
+  const Vector& rhs() const { return rhs_; }
+
+  /// Factors that are not stored in the matrix
+  const GaussianFactorGraph& otherFactors() const { return otherFactors_; }
+
+  /// y = A*x, where y has to have rows() entries
+  void multiply(const Vector& x, Vector& y) const;
+
+  /// x = A'*y, where x has to have cols() entries
+  void transposeMultiply(const Vector& y, Vector& x) const;
+
+  /**
+   * y = A'*A*x, including the Hessians of otherFactors(), where \c keyInfo is
+   * the layout the matrix was assembled with. The intermediate A*x is kept in
+   * a member between calls, so this must not be called concurrently on the
+   * same matrix.
+   */
+  void multiplyHessian(const Vector& x, Vector& y,
+                       const KeyInfo& keyInfo) const;
+
+  /**
+   * The negative gradient at zero, A'*b, including otherFactors(), where
+   * \c keyInfo is the layout the matrix was assembled with.
+   */
+  Vector negativeGradientAtZero(const KeyInfo& keyInfo) const;
+
+  /// Convert to a dense matrix [A b], for testing
+  Matrix augmentedMatrix() const;
+};
+
+} // \namespace gtsam
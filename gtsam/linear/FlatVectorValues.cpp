@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.cpp
+ * @brief   VectorValues stored in a single contiguous vector
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+  /* ************************************************************************* */
+  FlatVectorValues::Layout::Layout(const VectorValues& values) : offsets_(1, 0) {
+    // Sort keys, as the VectorValues container is not ordered with TBB
+    map<Key, DenseIndex> dims;
+    for (const auto& key_value : values)
+      dims.emplace(key_value.first, key_value.second.size());
+    keys_.reserve(dims.size());
+    offsets_.reserve(dims.size() + 1);
+    for (const auto& key_dim : dims)
+      add(key_dim.first, key_dim.second);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues::Layout::Layout(const Ordering& ordering,
+                                   const VectorValues::Dims& dims)
+      : offsets_(1, 0) {
+    keys_.reserve(ordering.size());
+    offsets_.reserve(ordering.size() + 1);
+    for (Key key : ordering) {
+      const auto it = dims.find(key);
+      if (it == dims.end())
+        throw invalid_argument(
+            "FlatVectorValues::Layout: inconsistent ordering and dimensions");
+      add(key, it->second);
+    }
+  }
+
+  /* ************************************************************************* */
+  void FlatVectorValues::Layout::add(Key key, DenseIndex dim) {
+    if (!index_.emplace(key, keys_.size()).second)
+      throw invalid_argument("Requested to add variable '" +
+                             DefaultKeyFormatter(key) +
+                             "' already in this FlatVectorValues layout.");
+    keys_.push_back(key);
+    offsets_.push_back(offsets_.back() + dim);
+  }
+
+  /* ************************************************************************* */
+  size_t FlatVectorValues::Layout::index(Key j) const {
+    const auto it = index_.find(j);
+    if (it == index_.end())
+      throw out_of_range("Requested variable '" + DefaultKeyFormatter(j) +
+                         "' is not in this FlatVectorValues.");
+    return it->second;
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues::FlatVectorValues(const LayoutPtr& layout, const Vector& data)
+      : layout_(layout), data_(data) {
+    if (data_.size() != layout_->dim())
+      throw invalid_argument(
+          "FlatVectorValues: data dimension does not match the layout");
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues::FlatVectorValues(const VectorValues& values)
+      : layout_(new Layout(values)) {
+    data_.resize(layout_->dim());
+    update(values);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues::FlatVectorValues(const VectorValues& values,
+                                     const LayoutPtr& layout)
+      : layout_(layout) {
+    if (values.size() != layout_->size())
+      throw invalid_argument(
+          "FlatVectorValues: VectorValues does not match the layout");
+    data_.resize(layout_->dim());
+    update(values);
+  }
+
+  /* ************************************************************************* */
+  VectorValues FlatVectorValues::vectorValues() const {
+    VectorValues result;
+    for (size_t i = 0; i < layout_->size(); ++i)
+      result.emplace(layout_->keys()[i],
+                     data_.segment(layout_->offset(i), layout_->dim(i)));
+    return result;
+  }
+
+  /* ************************************************************************* */
+  void FlatVectorValues::update(const VectorValues& values) {
+    for (const auto& key_value : values) {
+      const size_t i = layout_->index(key_value.first);
+      if (key_value.second.size() != layout_->dim(i))
+        throw invalid_argument("FlatVectorValues::update: variable '" +
+                               DefaultKeyFormatter(key_value.first) +
+                               "' has a different dimension");
+      data_.segment(layout_->offset(i), layout_->dim(i)) = key_value.second;
+    }
+  }
+
+  /* ************************************************************************* */
+  void FlatVectorValues::print(const string& str,
+                               const KeyFormatter& formatter) const {
+    cout << str << ": " << size() << " elements\n";
+    for (size_t i = 0; i < layout_->size(); ++i)
+      cout << "  " << formatter(layout_->keys()[i]) << ": "
+           << data_.segment(layout_->offset(i), layout_->dim(i)).transpose()
+           << "\n";
+    cout.flush();
+  }
+
+  /* ************************************************************************* */
+  bool FlatVectorValues::equals(const FlatVectorValues& x, double tol) const {
+    if (!hasSameStructure(x)) return false;
+    return equal_with_abs_tol(data_, x.data_, tol);
+  }
+
+  /* ************************************************************************* */
+  double FlatVectorValues::dot(const FlatVectorValues& v) const {
+    assert_throw(hasSameStructure(v),
+      invalid_argument("FlatVectorValues::dot called with a FlatVectorValues of different structure"));
+    return data_.dot(v.data_);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues FlatVectorValues::operator+(const FlatVectorValues& c) const {
+    assert_throw(hasSameStructure(c),
+      invalid_argument("FlatVectorValues::operator+ called with different structure"));
+    return FlatVectorValues(layout_, data_ + c.data_);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues FlatVectorValues::operator-(const FlatVectorValues& c) const {
+    assert_throw(hasSameStructure(c),
+      invalid_argument("FlatVectorValues::operator- called with different structure"));
+    return FlatVectorValues(layout_, data_ - c.data_);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues& FlatVectorValues::operator+=(const FlatVectorValues& c) {
+    assert_throw(hasSameStructure(c),
+      invalid_argument("FlatVectorValues::operator+= called with different structure"));
+    data_ += c.data_;
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues& FlatVectorValues::operator-=(const FlatVectorValues& c) {
+    assert_throw(hasSameStructure(c),
+      invalid_argument("FlatVectorValues::operator-= called with different structure"));
+    data_ -= c.data_;
+    return *this;
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues operator*(const double a, const FlatVectorValues& v) {
+    return FlatVectorValues(v.layout_, a * v.data_);
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues& FlatVectorValues::axpy(double alpha, const FlatVectorValues& x) {
+    assert_throw(hasSameStructure(x),
+      invalid_argument("FlatVectorValues::axpy called with different structure"));
+    data_.noalias() += alpha * x.data_;
+    return *this;
+  }
+
+} // \namespace gtsam
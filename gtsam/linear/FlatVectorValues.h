@@ -0,0 +1,244 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FlatVectorValues.h
+ * @brief   VectorValues stored in a single contiguous vector
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/Testable.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+  /**
+   * A VectorValues variant in which all variables live in one contiguous,
+   * aligned Vector. A Layout maps each key to an offset and dimension in that
+   * vector, and is shared (by pointer) between all FlatVectorValues with the
+   * same structure, e.g. the iterates, gradients and search directions of a
+   * conjugate gradient solver. Operations on the whole vector, such as dot,
+   * norm, scaling and axpy, are then single BLAS-1 loops over the contiguous
+   * data that Eigen can vectorize, and do not allocate.
+   *
+   * Per-variable access through at(Key) returns a SubVector view on the data.
+   * Convert from and to a regular VectorValues with the corresponding
+   * constructor and vectorValues().
+   * \nosubgrouping
+   */
+  class GTSAM_EXPORT FlatVectorValues {
+   public:
+
+    /** The position of each variable in the contiguous vector. Variables are
+     *  stored in the order in which they were added. */
+    class GTSAM_EXPORT Layout {
+      KeyVector keys_;                  ///< Keys in storage order
+      std::vector<DenseIndex> offsets_; ///< Offsets, one more than there are keys
+      FastMap<Key, size_t> index_;      ///< Position of each key in keys_
+
+     public:
+      /// Construct an empty layout
+      Layout() : offsets_(1, 0) {}
+
+      /// Construct with the keys and dimensions of a VectorValues, in key order
+      explicit Layout(const VectorValues& values);
+
+      /// Construct from an ordering and dimensions of all keys in it
+      Layout(const Ordering& ordering, const VectorValues::Dims& dims);
+
+      /// Append a variable, throws std::invalid_argument if the key exists
+      void add(Key key, DenseIndex dim);
+
+      /// Number of variables
+      size_t size() const { return keys_.size(); }
+
+      /// Total dimension
+      DenseIndex dim() const { return offsets_.back(); }
+
+      /// Keys in storage order
+      const KeyVector& keys() const { return keys_; }
+
+      /// Position of a key in storage order, throws std::out_of_range if absent
+      size_t index(Key j) const;
+
+      /// Check whether a key is part of this layout
+      bool exists(Key j) const { return index_.find(j) != index_.end(); }
+
+      /// Offset of the i'th variable in storage order
+      DenseIndex offset(size_t i) const { return offsets_[i]; }
+
+      /// Dimension of the i'th variable in storage order
+      DenseIndex dim(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+      /// Check whether two layouts have the same keys, dimensions, and order
+      bool equals(const Layout& other) const {
+        return keys_ == other.keys_ && offsets_ == other.offsets_;
+      }
+    };
+
+    typedef boost::shared_ptr<const Layout> LayoutPtr;  ///< Shared layout
+    typedef boost::shared_ptr<FlatVectorValues> shared_ptr;  ///< shared_ptr to this class
+
+   protected:
+    LayoutPtr layout_;  ///< Key to offset index, shared between vectors
+    Vector data_;       ///< Values of all variables, concatenated
+
+   public:
+    /// @name Standard Constructors
+    /// @{
+
+    /** Default constructor creates an empty FlatVectorValues. */
+    FlatVectorValues() : layout_(new Layout()) {}
+
+    /** Create a zero vector with the given layout. */
+    explicit FlatVectorValues(const LayoutPtr& layout)
+        : layout_(layout), data_(Vector::Zero(layout->dim())) {}
+
+    /** Create with the given layout and data, whose size has to match. */
+    FlatVectorValues(const LayoutPtr& layout, const Vector& data);
+
+    /** Copy a VectorValues, creating a new layout in key order. */
+    explicit FlatVectorValues(const VectorValues& values);
+
+    /** Copy a VectorValues into an existing layout, which must contain exactly
+     *  the keys of \c values with the same dimensions. */
+    FlatVectorValues(const VectorValues& values, const LayoutPtr& layout);
+
+    /** Create a FlatVectorValues sharing the layout of \c other, filled with zeros. */
+    static FlatVectorValues Zero(const FlatVectorValues& other) {
+      return FlatVectorValues(other.layout_);
+    }
+
+    /// @}
+    /// @name Standard Interface
+    /// @{
+
+    /** Number of variables stored. */
+    size_t size() const { return layout_->size(); }
+
+    /** Total dimension of all variables. */
+    size_t dim() const { return data_.size(); }
+
+    /** Return the dimension of variable \c j. */
+    size_t dim(Key j) const { return layout_->dim(layout_->index(j)); }
+
+    /** Check whether a variable with key \c j exists. */
+    bool exists(Key j) const { return layout_->exists(j); }
+
+    /** Read/write view on the vector value with key \c j, throws
+     *  std::out_of_range if \c j does not exist. */
+    SubVector at(Key j) {
+      const size_t i = layout_->index(j);
+      return data_.segment(layout_->offset(i), layout_->dim(i));
+    }
+
+    /** Read-only view on the vector value with key \c j, throws
+     *  std::out_of_range if \c j does not exist. */
+    ConstSubVector at(Key j) const {
+      const size_t i = layout_->index(j);
+      return data_.segment(layout_->offset(i), layout_->dim(i));
+    }
+
+    /** Identical to at(Key). */
+    SubVector operator[](Key j) { return at(j); }
+
+    /** Identical to at(Key). */
+    ConstSubVector operator[](Key j) const { return at(j); }
+
+    /** The shared layout. */
+    const LayoutPtr& layout() const { return layout_; }
+
+    /** The concatenated values of all variables, in layout order. */
+    const Vector& vector() const { return data_; }
+
+    /** The concatenated values of all variables, in layout order. */
+    Vector& vector() { return data_; }
+
+    /** Convert to a regular VectorValues. */
+    VectorValues vectorValues() const;
+
+    /** For all key/value pairs in \c values, replace the values with
+     *  corresponding keys in this class. Throws std::out_of_range if any keys
+     *  in \c values are not present in this class. */
+    void update(const VectorValues& values);
+
+    /** Set all values to zero. */
+    void setZero() { data_.setZero(); }
+
+    /** Check if this FlatVectorValues has the same layout as another. */
+    bool hasSameStructure(const FlatVectorValues& other) const {
+      return layout_ == other.layout_ || layout_->equals(*other.layout_);
+    }
+
+    /** print required by Testable for unit testing */
+    void print(const std::string& str = "FlatVectorValues",
+        const KeyFormatter& formatter = DefaultKeyFormatter) const;
+
+    /** equals required by Testable for unit testing */
+    bool equals(const FlatVectorValues& x, double tol = 1e-9) const;
+
+    /// @}
+    /// @name Linear algebra operations
+    /// @{
+
+    /** Dot product with another FlatVectorValues with the same structure. */
+    double dot(const FlatVectorValues& v) const;
+
+    /** Vector L2 norm */
+    double norm() const { return data_.norm(); }
+
+    /** Squared vector L2 norm */
+    double squaredNorm() const { return data_.squaredNorm(); }
+
+    /** Element-wise addition. Both must have the same structure. */
+    FlatVectorValues operator+(const FlatVectorValues& c) const;
+
+    /** Element-wise subtraction. Both must have the same structure. */
+    FlatVectorValues operator-(const FlatVectorValues& c) const;
+
+    /** Element-wise addition in-place. Both must have the same structure. */
+    FlatVectorValues& operator+=(const FlatVectorValues& c);
+
+    /** Element-wise subtraction in-place. Both must have the same structure. */
+    FlatVectorValues& operator-=(const FlatVectorValues& c);
+
+    /** Element-wise scaling by a constant in-place. */
+    FlatVectorValues& operator*=(double alpha) {
+      data_ *= alpha;
+      return *this;
+    }
+
+    /** Element-wise scaling by a constant. */
+    friend GTSAM_EXPORT FlatVectorValues operator*(const double a, const FlatVectorValues& v);
+
+    /** BLAS Level 1 axpy, this += alpha * x, without temporaries. */
+    FlatVectorValues& axpy(double alpha, const FlatVectorValues& x);
+
+    /// @}
+
+  }; // FlatVectorValues definition
+
+  /** BLAS Level 1 axpy: y <- alpha*x + y, used by the conjugate gradient templates */
+  inline void axpy(double alpha, const FlatVectorValues& x, FlatVectorValues& y) {
+    y.axpy(alpha, x);
+  }
+
+  /// traits
+  template<>
+  struct traits<FlatVectorValues> : public Testable<FlatVectorValues> {
+  };
+
+} // \namespace gtsam
@@ -157,6 +157,12 @@ namespace gtsam {
 
   }; // GaussianFactor
 
+/// Dimension of a variable of a Gaussian factor, for the clique cost estimates of JunctionTree
+inline size_t EliminationVariableDim(const GaussianFactor& factor,
+                                     GaussianFactor::const_iterator variable) {
+  return factor.getDim(variable);
+}
+
 /// traits
 template<>
 struct traits<GaussianFactor> : public Testable<GaussianFactor> {
@@ -20,6 +20,7 @@
 
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/FlatVectorValues.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianEliminationTree.h>
 #include <gtsam/linear/GaussianJunctionTree.h>
@@ -437,6 +438,121 @@ namespace gtsam {
     }
   }
 
+  /* ************************************************************************* */
+  namespace {
+    // Whitened A*x for a Jacobian factor into Ax, reading directly from contiguous storage
+    template <class VECTOR>
+    void multiplyFlat(const JacobianFactor& A, const FlatVectorValues& x, VECTOR& Ax) {
+      Ax.setZero();
+      for (JacobianFactor::const_iterator j = A.begin(); j != A.end(); ++j)
+        Ax.noalias() += A.getA(j) * x.at(*j);
+      if (A.get_model()) A.get_model()->whitenInPlace(Ax);
+    }
+
+    // Whitened A*x for a Jacobian factor
+    Vector multiplyFlat(const JacobianFactor& A, const FlatVectorValues& x) {
+      Vector Ax(A.rows());
+      multiplyFlat(A, x, Ax);
+      return Ax;
+    }
+
+    // x += alpha*A'*e for a Jacobian factor, writing directly into contiguous storage.
+    // e is whitened in place.
+    template <class VECTOR>
+    void transposeMultiplyAddFlat(const JacobianFactor& A, double alpha, VECTOR& e,
+                                  FlatVectorValues& x) {
+      if (A.get_model()) A.get_model()->whitenInPlace(e);
+      for (JacobianFactor::const_iterator j = A.begin(); j != A.end(); ++j)
+        x.at(*j).noalias() += alpha * (A.getA(j).transpose() * e);
+    }
+  }
+
+  /* ************************************************************************* */
+  FlatVectorValues GaussianFactorGraph::gradient(const FlatVectorValues& x0) const {
+    FlatVectorValues g = FlatVectorValues::Zero(x0);
+    for (const sharedFactor& factor: *this) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
+      Vector e = -Ai->getb();
+      for (JacobianFactor::const_iterator j = Ai->begin(); j != Ai->end(); ++j)
+        e.noalias() += Ai->getA(j) * x0.at(*j);
+      if (Ai->get_model()) Ai->get_model()->whitenInPlace(e);
+      transposeMultiplyAddFlat(*Ai, 1.0, e, g);
+    }
+    return g;
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::transposeMultiplyAdd(double alpha, const Errors& e,
+                                                 FlatVectorValues& x) const {
+    Errors::const_iterator ei = e.begin();
+    Vector E;
+    for (const sharedFactor& factor: *this) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
+      E = *(ei++);
+      transposeMultiplyAddFlat(*Ai, alpha, E, x);
+    }
+  }
+
+  /* ************************************************************************* */
+  Errors GaussianFactorGraph::operator*(const FlatVectorValues& x) const {
+    Errors e;
+    for (const GaussianFactor::shared_ptr& factor: *this) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
+      e.push_back(multiplyFlat(*Ai, x));
+    }
+    return e;
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::multiplyInPlace(const FlatVectorValues& x, Errors& e) const {
+    Errors::iterator ei = e.begin();
+    for (const GaussianFactor::shared_ptr& factor: *this) {
+      JacobianFactor::shared_ptr Ai = convertToJacobianFactorPtr(factor);
+      *(ei++) = multiplyFlat(*Ai, x);
+    }
+  }
+
+  /* ************************************************************************* */
+  void GaussianFactorGraph::multiplyHessianAdd(double alpha,
+      const FlatVectorValues& x, FlatVectorValues& y) const {
+    Vector scratch; // Whitened A*x of each Jacobian factor, sized for the largest one
+    for (const GaussianFactor::shared_ptr& factor: *this) {
+      if (!factor) continue;
+      if (const JacobianFactor::shared_ptr Ai =
+              boost::dynamic_pointer_cast<JacobianFactor>(factor)) {
+        const DenseIndex rows = Ai->rows();
+        if (rows == 0) continue;
+        if (scratch.size() < rows) scratch.resize(rows);
+        Eigen::Block<Vector> Ax = scratch.block(0, 0, rows, 1);
+        multiplyFlat(*Ai, x, Ax);
+        transposeMultiplyAddFlat(*Ai, alpha, Ax, y);
+      } else if (const HessianFactor::shared_ptr Hi =
+                     boost::dynamic_pointer_cast<HessianFactor>(factor)) {
+        // Same block loop as HessianFactor::multiplyHessianAdd
+        const SymmetricBlockMatrix& info = Hi->info();
+        const DenseIndex n = Hi->size();
+        for (DenseIndex j = 0; j < n; ++j) {
+          const ConstSubVector xj = x.at(Hi->keys()[j]);
+          for (DenseIndex i = 0; i < n; ++i) {
+            SubVector yi = y.at(Hi->keys()[i]);
+            if (i < j)
+              yi.noalias() += alpha * (info.aboveDiagonalBlock(i, j) * xj);
+            else if (i == j)
+              yi.noalias() += alpha * (info.diagonalBlock(j) * xj);
+            else
+              yi.noalias() += alpha * (info.aboveDiagonalBlock(j, i).transpose() * xj);
+          }
+        }
+      } else {
+        // Other factor types only implement the VectorValues interface
+        VectorValues xf, yf;
+        for (Key key: factor->keys()) xf.emplace(key, x.at(key));
+        factor->multiplyHessianAdd(alpha, xf, yf);
+        for (const VectorValues::KeyValuePair& yj: yf) y.at(yj.first) += yj.second;
+      }
+    }
+  }
+
   ///* ************************************************************************* */
   //void residual(const GaussianFactorGraph& fg, const VectorValues &x, VectorValues &r) {
   //  Key i = 0 ;
@@ -38,6 +38,7 @@ namespace gtsam {
   class GaussianEliminationTree;
   class GaussianBayesTree;
   class GaussianJunctionTree;
+  class FlatVectorValues;
 
   /* ************************************************************************* */
   template<> struct EliminationTraits<GaussianFactorGraph>
@@ -366,6 +367,28 @@ namespace gtsam {
     void multiplyInPlace(const VectorValues& x, const Errors::iterator& e) const;
 
     /// @}
+    /// @name Linear Algebra on contiguous FlatVectorValues
+    /// @{
+
+    /** Gradient \f$ A^T(Ax-b) \f$ at x0, see gradient(const VectorValues&). The
+     *  result shares the layout of \c x0. */
+    FlatVectorValues gradient(const FlatVectorValues& x0) const;
+
+    /** x += alpha*A'*e */
+    void transposeMultiplyAdd(double alpha, const Errors& e, FlatVectorValues& x) const;
+
+    /** return A*x */
+    Errors operator*(const FlatVectorValues& x) const;
+
+    /** In-place version e <- A*x that overwrites e. */
+    void multiplyInPlace(const FlatVectorValues& x, Errors& e) const;
+
+    /** y += alpha*A'A*x, with Jacobian and Hessian factors read and written in
+     *  place in the contiguous storage.  \c y must have the layout of \c x. */
+    void multiplyHessianAdd(double alpha, const FlatVectorValues& x,
+        FlatVectorValues& y) const;
+
+    /// @}
 
   private:
     /** Serialization function */
@@ -0,0 +1,68 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    GraphStructureSignature.cpp
+ * @brief   The structure of a Gaussian factor graph, to detect when it can be reused
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/GraphStructureSignature.h>
+
+#include <algorithm>
+
+namespace gtsam {
+
+namespace {
+const size_t nullFactor = size_t(-1);
+}
+
+/* ************************************************************************* */
+GraphStructureSignature::GraphStructureSignature(const GaussianFactorGraph& graph) :
+    recorded_(true) {
+  factorSizes_.reserve(graph.size());
+  for (const GaussianFactor::shared_ptr& factor : graph) {
+    if (factor) {
+      factorSizes_.push_back(factor->size());
+      keys_.insert(keys_.end(), factor->begin(), factor->end());
+    } else {
+      factorSizes_.push_back(nullFactor);
+    }
+  }
+}
+
+/* ************************************************************************* */
+bool GraphStructureSignature::matches(const GaussianFactorGraph& graph) const {
+  if (!recorded_ || graph.size() != factorSizes_.size())
+    return false;
+  KeyVector::const_iterator keys = keys_.begin();
+  for (size_t i = 0; i < graph.size(); ++i) {
+    const GaussianFactor::shared_ptr& factor = graph[i];
+    if (!factor) {
+      if (factorSizes_[i] != nullFactor)
+        return false;
+    } else {
+      if (factor->size() != factorSizes_[i] || !std::equal(factor->begin(), factor->end(), keys))
+        return false;
+      keys += factor->size();
+    }
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+void GraphStructureSignature::clear() {
+  factorSizes_.clear();
+  keys_.clear();
+  recorded_ = false;
+}
+
+}
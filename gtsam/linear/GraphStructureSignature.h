@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    GraphStructureSignature.h
+ * @brief   The structure of a Gaussian factor graph, to detect when it can be reused
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/inferenceExceptions.h>
+
+#include <unordered_map>
+
+namespace gtsam {
+
+  /**
+   * The structure of a GaussianFactorGraph, i.e., the keys of each factor, in order, and which
+   * factors are null.  Caches of symbolic data compare the graph of each call against the
+   * signature of the graph their data was computed for.
+   */
+  class GTSAM_EXPORT GraphStructureSignature
+  {
+  public:
+    /** Construct an empty signature, which matches no graph */
+    GraphStructureSignature() : recorded_(false) {}
+
+    /** Record the structure of \c graph */
+    explicit GraphStructureSignature(const GaussianFactorGraph& graph);
+
+    /** Whether \c graph has the recorded structure */
+    bool matches(const GaussianFactorGraph& graph) const;
+
+    /** Forget the recorded structure */
+    void clear();
+
+  private:
+    FastVector<size_t> factorSizes_; ///< The number of keys of each factor, or -1 if it is null
+    KeyVector keys_; ///< The keys of all factors, concatenated
+    bool recorded_;
+  };
+
+  namespace internal {
+
+    /// Call f on each factor of the nodes of an elimination or junction tree, always in the same
+    /// order.  This uses an explicit stack rather than recursion, as the trees can be very deep.
+    template <class TREE, class FUNCTION>
+    void forEachTreeFactor(const TREE& tree, const FUNCTION& f) {
+      FastVector<typename TREE::sharedNode> stack(tree.roots().begin(), tree.roots().end());
+      while (!stack.empty()) {
+        const typename TREE::sharedNode node = stack.back();
+        stack.pop_back();
+        for (GaussianFactor::shared_ptr& factor : node->factors)
+          f(factor);
+        stack.insert(stack.end(), node->children.begin(), node->children.end());
+      }
+    }
+
+    /// Remove the factors of \c graph from \c tree, which was built from it, and return the index
+    /// in the graph of each, in the order of forEachTreeFactor.  Factors that appear several
+    /// times in the graph take their first unused index.  Throws
+    /// InconsistentEliminationRequested if the tree has remaining factors.
+    template <class TREE>
+    FastVector<size_t> detachTreeFactors(TREE& tree, const GaussianFactorGraph& graph) {
+      if (!tree.remainingFactors().empty())
+        throw InconsistentEliminationRequested();
+      std::unordered_map<const GaussianFactor*, FastVector<size_t> > indices;
+      for (size_t i = graph.size(); i-- > 0;)
+        if (graph[i])
+          indices[graph[i].get()].push_back(i);
+      FastVector<size_t> factorIndices;
+      forEachTreeFactor(tree, [&](GaussianFactor::shared_ptr& factor) {
+        FastVector<size_t>& factorIndex = indices.at(factor.get());
+        factorIndices.push_back(factorIndex.back());
+        factorIndex.pop_back();
+        factor.reset();
+      });
+      return factorIndices;
+    }
+
+    /// Eliminate \c tree into a Bayes net or tree, with the factors of \c graph, which has the
+    /// structure of the graph the tree was built from, put back at \c factorIndices.  The
+    /// factors are removed from the tree again once done, even if elimination throws.
+    template <class TREE>
+    auto eliminateTreeWith(const TREE& tree, const GaussianFactorGraph& graph,
+        const FastVector<size_t>& factorIndices, const typename TREE::Eliminate& function)
+        -> decltype(tree.eliminate(function).first) {
+      struct FactorsScope {
+        const TREE& tree;
+        ~FactorsScope() {
+          forEachTreeFactor(tree, [](GaussianFactor::shared_ptr& factor) { factor.reset(); });
+        }
+      } factorsScope{tree};
+
+      size_t i = 0;
+      forEachTreeFactor(tree, [&](GaussianFactor::shared_ptr& factor) {
+        factor = graph[factorIndices[i++]];
+      });
+
+      decltype(tree.eliminate(function).first) result;
+      GaussianFactorGraph::shared_ptr remaining;
+      boost::tie(result, remaining) = tree.eliminate(function);
+      if (!remaining->empty())
+        throw InconsistentEliminationRequested();
+      return result;
+    }
+
+  }
+
+}
@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultifrontalStructureCache.cpp
+ * @brief   Multifrontal elimination that reuses the symbolic structure of the previous graph
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/MultifrontalStructureCache.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/linear/GaussianJunctionTree.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MultifrontalStructureCache::MultifrontalStructureCache() : nrReused_(0), nrBuilt_(0) {}
+
+/* ************************************************************************* */
+MultifrontalStructureCache::~MultifrontalStructureCache() {}
+
+/* ************************************************************************* */
+GaussianBayesTree::shared_ptr MultifrontalStructureCache::eliminate(
+    const GaussianFactorGraph& graph, const Ordering& ordering, const Eliminate& function) {
+  if (sameStructure(graph) && ordering == ordering_) {
+    ++nrReused_;
+  } else {
+    build(graph, ordering);
+    ++nrBuilt_;
+  }
+  return eliminateCached(graph, function);
+}
+
+/* ************************************************************************* */
+GaussianBayesTree::shared_ptr MultifrontalStructureCache::eliminate(
+    const GaussianFactorGraph& graph, Ordering::OrderingType orderingType,
+    const Eliminate& function) {
+  if (sameStructure(graph)) {
+    ++nrReused_;
+  } else {
+    build(graph, orderingType == Ordering::METIS ? Ordering::Metis(graph) : Ordering::Colamd(graph));
+    ++nrBuilt_;
+  }
+  return eliminateCached(graph, function);
+}
+
+/* ************************************************************************* */
+void MultifrontalStructureCache::clear() {
+  signature_.clear();
+  ordering_.clear();
+  junctionTree_.reset();
+  factorIndices_.clear();
+}
+
+/* ************************************************************************* */
+bool MultifrontalStructureCache::sameStructure(const GaussianFactorGraph& graph) const {
+  return junctionTree_ && signature_.matches(graph);
+}
+
+/* ************************************************************************* */
+void MultifrontalStructureCache::build(const GaussianFactorGraph& graph,
+                                       const Ordering& ordering) {
+  gttic(MultifrontalStructureCache_build);
+  clear();
+  GaussianEliminationTree etree(graph, ordering);
+  std::unique_ptr<GaussianJunctionTree> junctionTree(new GaussianJunctionTree(etree));
+
+  // Remove the factors, remembering where they are in the graph
+  FastVector<size_t> factorIndices = internal::detachTreeFactors(*junctionTree, graph);
+
+  signature_ = GraphStructureSignature(graph);
+  ordering_ = ordering;
+  junctionTree_ = std::move(junctionTree);
+  factorIndices_ = std::move(factorIndices);
+}
+
+/* ************************************************************************* */
+GaussianBayesTree::shared_ptr MultifrontalStructureCache::eliminateCached(
+    const GaussianFactorGraph& graph, const Eliminate& function) const {
+  gttic(MultifrontalStructureCache_eliminate);
+  return internal::eliminateTreeWith(*junctionTree_, graph, factorIndices_, function);
+}
+
+}
@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    MultifrontalStructureCache.h
+ * @brief   Multifrontal elimination that reuses the symbolic structure of the previous graph
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GraphStructureSignature.h>
+#include <gtsam/inference/Ordering.h>
+
+#include <memory>
+
+namespace gtsam {
+
+  // Forward declarations
+  class GaussianJunctionTree;
+
+  /**
+   * Multifrontal elimination of Gaussian factor graphs that skips the symbolic phase - computing
+   * the VariableIndex, the ordering if none is given, and the elimination and junction trees -
+   * when the graph has the same structure as the one of the previous call, i.e., the same keys in
+   * the same factors at the same positions.  This is the case for the linear graphs of successive
+   * iterations of the nonlinear optimizers, for which only the numerical factorization then needs
+   * to be repeated.  The resulting Bayes trees are the same as with
+   * GaussianFactorGraph::eliminateMultifrontal.
+   *
+   * Only the structure of the junction tree is kept between calls, not the factors, so that the
+   * factors of the previous graph are not kept alive.
+   */
+  class GTSAM_EXPORT MultifrontalStructureCache
+  {
+  public:
+    typedef GaussianFactorGraph::Eliminate Eliminate;
+    typedef GaussianFactorGraph::EliminationTraitsType EliminationTraitsType;
+
+    /** Construct with an empty cache */
+    MultifrontalStructureCache();
+
+    ~MultifrontalStructureCache();
+
+    /** Eliminate \c graph with \c ordering, like GaussianFactorGraph::eliminateMultifrontal */
+    GaussianBayesTree::shared_ptr eliminate(const GaussianFactorGraph& graph,
+      const Ordering& ordering,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate);
+
+    /** Eliminate \c graph with a METIS ordering if \c orderingType is METIS, or a COLAMD ordering
+     *  otherwise, like GaussianFactorGraph::eliminateMultifrontal.  The ordering is only computed
+     *  if the structure of the graph has changed. */
+    GaussianBayesTree::shared_ptr eliminate(const GaussianFactorGraph& graph,
+      Ordering::OrderingType orderingType,
+      const Eliminate& function = EliminationTraitsType::DefaultEliminate);
+
+    /** The ordering of the cached structure */
+    const Ordering& ordering() const { return ordering_; }
+
+    /** The number of eliminations that reused the cached structure */
+    size_t nrReused() const { return nrReused_; }
+
+    /** The number of eliminations that built a new structure */
+    size_t nrBuilt() const { return nrBuilt_; }
+
+    /** Forget the cached structure */
+    void clear();
+
+  private:
+    /// Whether \c graph has the same structure as the cached one
+    bool sameStructure(const GaussianFactorGraph& graph) const;
+
+    /// Build and cache the structure of \c graph with \c ordering
+    void build(const GaussianFactorGraph& graph, const Ordering& ordering);
+
+    /// Eliminate \c graph, which has the cached structure
+    GaussianBayesTree::shared_ptr eliminateCached(const GaussianFactorGraph& graph,
+      const Eliminate& function) const;
+
+    GraphStructureSignature signature_; ///< Of the graph the structure was built for
+    Ordering ordering_;
+    std::unique_ptr<GaussianJunctionTree> junctionTree_; ///< The junction tree, without factors
+    FastVector<size_t> factorIndices_; ///< The index in the graph of each factor of the junction tree
+    size_t nrReused_;
+    size_t nrBuilt_;
+  };
+
+}
@@ -298,6 +298,16 @@ Vector Diagonal::unwhiten(const Vector& v) const {
   return v.cwiseProduct(sigmas_);
 }
 
+/* ************************************************************************* */
+void Diagonal::whitenInPlace(Vector& v) const {
+  v.array() *= invsigmas_.array();
+}
+
+/* ************************************************************************* */
+void Diagonal::whitenInPlace(Eigen::Block<Vector>& v) const {
+  v.array() *= invsigmas_.array();
+}
+
 /* ************************************************************************* */
 Matrix Diagonal::Whiten(const Matrix& H) const {
   return vector_scale(invsigmas(), H);
@@ -667,6 +677,104 @@ Robust::shared_ptr Robust::Create(
   return shared_ptr(new Robust(robust,noise));
 }
 
+/* ************************************************************************* */
+// Batched whitening
+/* ************************************************************************* */
+namespace {
+
+// Whiten the N stacked systems of m rows in A (if given) and b, where modelAt(i) is the noise
+// model of system i
+template <class MODEL_AT>
+void whitenStacked(size_t N, DenseIndex m, const MODEL_AT& modelAt, Eigen::Ref<Matrix>* A,
+                   Eigen::Ref<Vector> b) {
+  size_t first = 0;
+  while (first < N) {
+    // Models are usually shared between systems, so find the run of systems with this one
+    const Base& model = modelAt(first);
+    if (model.dim() != size_t(m))
+      throw invalid_argument("WhitenSystems: noise models differ in dimension");
+    size_t last = first + 1;
+    while (last < N && &modelAt(last) == &model) ++last;
+
+    const Diagonal* diagonal =
+        model.isConstrained() ? nullptr : dynamic_cast<const Diagonal*>(&model);
+    if (model.isUnit()) {
+      // Nothing to do
+    } else if (diagonal) {
+      // The rows of a column of the run form an m x (last - first) matrix, whose columns are
+      // all scaled by the inverse sigmas, in place
+      const Vector& invsigmas = diagonal->invsigmas();
+      const DenseIndex n = last - first;
+      if (A)
+        for (DenseIndex j = 0; j < A->cols(); ++j)
+          Eigen::Map<Matrix>(A->col(j).data() + first * m, m, n).array().colwise() *=
+              invsigmas.array();
+      Eigen::Map<Matrix>(b.data() + first * m, m, n).array().colwise() *= invsigmas.array();
+    } else {
+      // Other models system by system
+      for (size_t i = first; i < last; ++i) {
+        if (A) {
+          Matrix Ai = A->middleRows(i * m, m);
+          Vector bi = b.segment(i * m, m);
+          model.WhitenSystem(Ai, bi);
+          A->middleRows(i * m, m) = Ai;
+          b.segment(i * m, m) = bi;
+        } else {
+          b.segment(i * m, m) = model.whiten(b.segment(i * m, m));
+        }
+      }
+    }
+    first = last;
+  }
+}
+
+// Check that the stacked rows are a multiple of the dimension m of the noise models, and return
+// the number of systems
+size_t nrStackedSystems(DenseIndex rows, size_t m) {
+  if (m == 0 || rows % DenseIndex(m) != 0)
+    throw invalid_argument("WhitenSystems: rows are not a multiple of the noise model dimension");
+  return rows / m;
+}
+
+// Whiten with one model per system, or a single shared one
+void whitenStacked(const vector<Base::shared_ptr>& models, Eigen::Ref<Matrix>* A,
+                   Eigen::Ref<Vector> b) {
+  if (models.empty() || !models.front())
+    throw invalid_argument("WhitenSystems: no noise model given");
+  const size_t m = models.front()->dim();
+  const size_t N = nrStackedSystems(b.size(), m);
+  if (models.size() == 1)
+    return whitenStacked(N, m, [&](size_t) -> const Base& { return *models.front(); }, A, b);
+  if (models.size() != N)
+    throw invalid_argument("WhitenSystems: need one noise model, or one per system");
+  for (const Base::shared_ptr& model : models)
+    if (!model) throw invalid_argument("WhitenSystems: no noise model given");
+  whitenStacked(N, m, [&](size_t i) -> const Base& { return *models[i]; }, A, b);
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void WhitenSystems(const vector<Base::shared_ptr>& models, Eigen::Ref<Matrix> A,
+                   Eigen::Ref<Vector> b) {
+  if (A.rows() != b.size())
+    throw invalid_argument("WhitenSystems: A and b have different numbers of rows");
+  whitenStacked(models, &A, b);
+}
+
+/* ************************************************************************* */
+void WhitenSystems(const vector<Base::shared_ptr>& models, Eigen::Ref<Vector> b) {
+  whitenStacked(models, nullptr, b);
+}
+
+/* ************************************************************************* */
+void WhitenSystems(const Base& model, Eigen::Ref<Matrix> A, Eigen::Ref<Vector> b) {
+  if (A.rows() != b.size())
+    throw invalid_argument("WhitenSystems: A and b have different numbers of rows");
+  const size_t N = nrStackedSystems(b.size(), model.dim());
+  whitenStacked(N, model.dim(), [&](size_t) -> const Base& { return model; }, &A, b);
+}
+
 /* ************************************************************************* */
 
 }
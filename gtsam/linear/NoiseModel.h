@@ -27,6 +27,7 @@
 #include <boost/serialization/extended_type_info.hpp>
 #include <boost/serialization/singleton.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/serialization/optional.hpp>
 
 namespace gtsam {
@@ -339,6 +340,8 @@ namespace gtsam {
       virtual Vector sigmas() const { return sigmas_; }
       virtual Vector whiten(const Vector& v) const;
       virtual Vector unwhiten(const Vector& v) const;
+      virtual void whitenInPlace(Vector& v) const;
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const;
       virtual Matrix Whiten(const Matrix& H) const;
       virtual void WhitenInPlace(Matrix& H) const;
       virtual void WhitenInPlace(Eigen::Block<Matrix> H) const;
@@ -498,6 +501,8 @@ namespace gtsam {
 
       /// Calculates error vector with weights applied
       virtual Vector whiten(const Vector& v) const;
+      virtual void whitenInPlace(Vector& v) const { v = whiten(v); }
+      virtual void whitenInPlace(Eigen::Block<Vector>& v) const { v = whiten(v); }
 
       /// Whitening functions will perform partial whitening on rows
       /// with a non-zero sigma.  Other rows remain untouched.
@@ -742,6 +747,29 @@ namespace gtsam {
     // Helper function
     GTSAM_EXPORT boost::optional<Vector> checkIfDiagonal(const Matrix M);
 
+    /**
+     * Whiten N systems A_i x = b_i with the same number of rows m in one pass, instead of calling
+     * WhitenSystem once per system.  The systems are stacked row-wise, A = [A_1; ...; A_N] and
+     * b = [b_1; ...; b_N], so \c A has N*m rows.  \c models has either one noise model per
+     * system, or a single model shared by all systems.
+     *
+     * Consecutive systems that share a Diagonal, Isotropic or Unit noise model are whitened
+     * together, by scaling their rows of A and b with the inverse sigmas in place, one pass per
+     * column.  Other models (full Gaussian, Constrained, Robust) fall back to WhitenSystem on
+     * their rows.  This is for callers that already store several systems contiguously, such as
+     * the fixed-size [H1 H2 b] of GeneralSFMFactor.
+     */
+    GTSAM_EXPORT void WhitenSystems(const std::vector<Base::shared_ptr>& models,
+                                    Eigen::Ref<Matrix> A, Eigen::Ref<Vector> b);
+
+    /** Whiten N stacked residuals b = [b_1; ...; b_N] in one pass, like WhitenSystems */
+    GTSAM_EXPORT void WhitenSystems(const std::vector<Base::shared_ptr>& models,
+                                    Eigen::Ref<Vector> b);
+
+    /** Whiten N stacked systems that all share \c model, without a vector of models */
+    GTSAM_EXPORT void WhitenSystems(const Base& model, Eigen::Ref<Matrix> A,
+                                    Eigen::Ref<Vector> b);
+
   } // namespace noiseModel
 
   /** Note, deliberately not in noiseModel namespace.
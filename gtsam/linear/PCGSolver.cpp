@@ -18,11 +18,14 @@
  */
 
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/BlockSparseRowMatrix.h>
+#include <gtsam/linear/FlatVectorValues.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/make_shared.hpp>
 
 #include <algorithm>
 #include <iostream>
@@ -52,8 +55,14 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
   /* build preconditioner */
   preconditioner_->build(gfg, keyInfo, lambda);
 
+  /* assemble the operator once for the BSR kernel */
+  boost::shared_ptr<BlockSparseRowMatrix> bsr;
+  if (parameters_.blas_kernel_ == ConjugateGradientParameters::BSR)
+    bsr = boost::make_shared<BlockSparseRowMatrix>(gfg, keyInfo);
+
   /* apply pcg */
-  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
+  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda,
+                                   bsr.get());
   Vector x0 = initial.vector(keyInfo.ordering());
   const Vector sol = preconditionedConjugateGradient(system, x0, parameters_);
 
@@ -63,9 +72,20 @@ VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
 /*****************************************************************************/
 GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
-    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    const BlockSparseRowMatrix *bsr) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
-        lambda) {
+        lambda), bsr_(bsr) {
+  if (!bsr_) {
+    // Variables are stored in the KeyInfo ordering, as in the iterate vectors
+    boost::shared_ptr<FlatVectorValues::Layout> layout =
+        boost::make_shared<FlatVectorValues::Layout>();
+    for (const Key key : keyInfo_.ordering())
+      layout->add(key, keyInfo_.find(key)->second.dim);
+    layout_ = layout;
+    flatX_ = FlatVectorValues(layout_);
+    flatAtAx_ = FlatVectorValues(layout_);
+  }
 }
 
 /*****************************************************************************/
@@ -84,23 +104,30 @@ void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
 /*****************************************************************************/
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
+  if (bsr_) {
+    bsr_->multiplyHessian(x, AtAx, keyInfo_);
+    return;
+  }
 
-  // Build a VectorValues for Vector x
-  VectorValues vvX = buildVectorValues(x, keyInfo_);
-
-  // VectorValues form of A'Ax for multiplyHessianAdd
-  VectorValues vvAtAx = keyInfo_.x0(); // crucial for performance
+  // View x and A'Ax in the KeyInfo ordering, without splitting them per key.
+  // The storage of AtAx is swapped in and out of flatAtAx_, so it is not copied.
+  flatX_.vector() = x;
+  AtAx.setZero(layout_->dim());
+  flatAtAx_.vector().swap(AtAx);
 
-  // vvAtAx += 1.0 * A'Ax for each factor
-  gfg_.multiplyHessianAdd(1.0, vvX, vvAtAx);
+  // flatAtAx_ += 1.0 * A'Ax for each factor
+  gfg_.multiplyHessianAdd(1.0, flatX_, flatAtAx_);
 
-  // Make the result as Vector form
-  AtAx = vvAtAx.vector(keyInfo_.ordering());
+  flatAtAx_.vector().swap(AtAx);
 }
 
 /*****************************************************************************/
 void GaussianFactorGraphSystem::getb(Vector &b) const {
   /* compute rhs, assume b pre-allocated */
+  if (bsr_) {
+    b = bsr_->negativeGradientAtZero(keyInfo_);
+    return;
+  }
 
   // Get whitened r.h.s (A^T * b) from each factor in the form of VectorValues
   VectorValues vvb = gfg_.gradientAtZero();
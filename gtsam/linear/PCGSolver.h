@@ -20,10 +20,12 @@
 #pragma once
 
 #include <gtsam/linear/ConjugateGradientSolver.h>
+#include <gtsam/linear/FlatVectorValues.h>
 #include <string>
 
 namespace gtsam {
 
+class BlockSparseRowMatrix;
 class GaussianFactorGraph;
 class KeyInfo;
 class Preconditioner;
@@ -80,18 +82,29 @@ public:
 
 /**
  * System class needed for calling preconditionedConjugateGradient
+ * If a BlockSparseRowMatrix assembled from the graph is given, products with
+ * the Hessian and the right-hand side use it instead of the factors (the BSR
+ * kernel of ConjugateGradientParameters).  Otherwise, the Hessian products
+ * are computed on FlatVectorValues that share one layout in the KeyInfo
+ * ordering, and that are kept between iterations, so that neither per-key
+ * VectorValues nor new vectors are allocated in each iteration.
  */
 class GTSAM_EXPORT GaussianFactorGraphSystem {
 public:
 
   GaussianFactorGraphSystem(const GaussianFactorGraph &gfg,
       const Preconditioner &preconditioner, const KeyInfo &info,
-      const std::map<Key, Vector> &lambda);
+      const std::map<Key, Vector> &lambda,
+      const BlockSparseRowMatrix *bsr = nullptr);
 
   const GaussianFactorGraph &gfg_;
   const Preconditioner &preconditioner_;
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
+  const BlockSparseRowMatrix *bsr_;
+  FlatVectorValues::LayoutPtr layout_; ///< Of x in multiply, when bsr_ is null
+  mutable FlatVectorValues flatX_;     ///< x in multiply, re-used across iterations
+  mutable FlatVectorValues flatAtAx_;  ///< A'Ax in multiply, swapped with the result
 
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
@@ -12,6 +12,8 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/inference/Symbol.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -22,6 +24,107 @@ using namespace std;
 
 namespace gtsam {
 
+namespace {
+/* The lower triangle of the Hessian of a graph in blocks, indexed by the
+ * positions of the variables in the KeyInfo ordering: lower[j] maps i >= j to
+ * block (i, j), and always contains the diagonal block. */
+typedef vector<map<size_t, Matrix> > LowerBlocks;
+
+LowerBlocks lowerHessianBlocks(const GaussianFactorGraph &gfg,
+                               const KeyInfo &keyInfo) {
+  const vector<size_t> dims = keyInfo.colSpec();
+  LowerBlocks lower(dims.size());
+  for (size_t j = 0; j < dims.size(); ++j)
+    lower[j].emplace(j, Matrix::Zero(dims[j], dims[j]));
+
+  for (const GaussianFactor::shared_ptr &factor : gfg) {
+    if (!factor) continue;
+    const Matrix information = factor->information();
+    vector<size_t> positions;
+    vector<DenseIndex> offsets(1, 0);
+    for (auto key = factor->begin(); key != factor->end(); ++key) {
+      positions.push_back(keyInfo.at(*key).index);
+      offsets.push_back(offsets.back() + factor->getDim(key));
+    }
+    for (size_t a = 0; a < positions.size(); ++a)
+      for (size_t b = 0; b < positions.size(); ++b) {
+        const size_t i = positions[a], j = positions[b];
+        if (i < j) continue;
+        const auto block = information.block(offsets[a], offsets[b],
+            offsets[a + 1] - offsets[a], offsets[b + 1] - offsets[b]);
+        const auto it = lower[j].find(i);
+        if (it == lower[j].end())
+          lower[j].emplace(i, block);
+        else
+          it->second += block;
+      }
+  }
+  return lower;
+}
+
+/* Scalar offset of each variable, by position in the KeyInfo ordering */
+vector<size_t> scalarStarts(const KeyInfo &keyInfo) {
+  vector<size_t> starts(keyInfo.size());
+  for (const KeyInfo::value_type &key_info : keyInfo)
+    starts[key_info.second.index] = key_info.second.start;
+  return starts;
+}
+
+/* Incomplete block Cholesky factorization of a Hessian whose diagonal is
+ * scaled by 1 + shift, keeping fill up to fillLevel.  Returns the position of
+ * the variable where it broke down, or the number of variables on success. */
+size_t incompleteCholesky(const LowerBlocks &hessian, size_t fillLevel,
+                          double shift, vector<Matrix> *diagonal,
+                          vector<vector<pair<size_t, Matrix> > > *columns) {
+  const size_t n = hessian.size();
+
+  // Working copy of the blocks, with their fill level
+  vector<map<size_t, pair<size_t, Matrix> > > work(n);
+  for (size_t j = 0; j < n; ++j) {
+    for (const auto &i_block : hessian[j])
+      work[j].emplace(i_block.first, make_pair(size_t(0), i_block.second));
+    work[j].at(j).second.diagonal() *= 1.0 + shift;
+  }
+
+  diagonal->assign(n, Matrix());
+  columns->assign(n, vector<pair<size_t, Matrix> >());
+  vector<size_t> levels;
+  for (size_t k = 0; k < n; ++k) {
+    // L_kk = chol(A_kk), and L_ik = A_ik * L_kk^-T
+    const Eigen::LLT<Matrix> llt(work[k].at(k).second);
+    if (llt.info() != Eigen::Success) return k;
+    (*diagonal)[k] = llt.matrixL();
+    vector<pair<size_t, Matrix> > &column = (*columns)[k];
+    levels.clear();
+    for (const auto &i_block : work[k]) {
+      if (i_block.first == k) continue;
+      column.emplace_back(i_block.first, llt.matrixL()
+          .solve(i_block.second.second.transpose()).transpose());
+      levels.push_back(i_block.second.first);
+    }
+    work[k].clear();
+
+    // A_il -= L_ik * L_lk', where the block exists or its level is low enough
+    for (size_t a = 0; a < column.size(); ++a)
+      for (size_t b = 0; b <= a; ++b) {
+        const size_t i = column[a].first, l = column[b].first;
+        const size_t level = levels[a] + levels[b] + 1;
+        auto it = work[l].find(i);
+        if (it == work[l].end()) {
+          if (level > fillLevel) continue;
+          it = work[l].emplace(i, make_pair(level, Matrix::Zero(
+              column[a].second.rows(), column[b].second.rows()))).first;
+        } else {
+          it->second.first = min(it->second.first, level);
+        }
+        it->second.second.noalias() -=
+            column[a].second * column[b].second.transpose();
+      }
+  }
+  return n;
+}
+}  // namespace
+
 /*****************************************************************************/
 void PreconditionerParameters::print() const {
   print(cout);
@@ -182,6 +285,238 @@ void BlockJacobiPreconditioner::clean() {
   }
 }
 
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "fillLevel:     " << fillLevel_ << endl;
+}
+
+/***************************************************************************************/
+BlockIncompleteCholeskyPreconditioner::BlockIncompleteCholeskyPreconditioner(
+    const BlockIncompleteCholeskyPreconditionerParameters &p)
+  : Base(), parameters_(p), shift_(0.0) {}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  // Forward substitution with the block columns of L
+  x = y;
+  for (size_t k = 0; k < diagonal_.size(); ++k) {
+    auto xk = x.segment(starts_[k], diagonal_[k].rows());
+    diagonal_[k].triangularView<Eigen::Lower>().solveInPlace(xk);
+    for (const auto &i_block : columns_[k])
+      x.segment(starts_[i_block.first], i_block.second.rows()).noalias() -=
+          i_block.second * xk;
+  }
+}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  // Back substitution with the block rows of L'
+  x = y;
+  for (size_t k = diagonal_.size(); k-- > 0;) {
+    auto xk = x.segment(starts_[k], diagonal_[k].rows());
+    for (const auto &i_block : columns_[k])
+      xk.noalias() -= i_block.second.transpose() *
+          x.segment(starts_[i_block.first], i_block.second.rows());
+    diagonal_[k].transpose().triangularView<Eigen::Upper>().solveInPlace(xk);
+  }
+}
+
+/***************************************************************************************/
+void BlockIncompleteCholeskyPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  starts_ = scalarStarts(keyInfo);
+  const LowerBlocks hessian = lowerHessianBlocks(gfg, keyInfo);
+
+  /* retry with a growing diagonal shift when the factorization breaks down */
+  for (shift_ = 0.0;; shift_ = (shift_ == 0.0) ? 1e-3 : 2.0 * shift_) {
+    const size_t failed = incompleteCholesky(hessian, parameters_.fillLevel_,
+                                             shift_, &diagonal_, &columns_);
+    if (failed == hessian.size()) return;
+    if (shift_ > 1e3)
+      throw IndeterminantLinearSystemException(keyInfo.ordering()[failed]);
+  }
+}
+
+/***************************************************************************************/
+size_t BlockIncompleteCholeskyPreconditioner::nrOffDiagonalBlocks() const {
+  size_t count = 0;
+  for (const auto &column : columns_) count += column.size();
+  return count;
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "pointTypes:    ";
+  for (unsigned char chr : pointTypes_) os << chr;
+  os << endl << "clusterSize:   " << clusterSize_ << endl;
+}
+
+/***************************************************************************************/
+ClusterJacobiPreconditioner::ClusterJacobiPreconditioner(
+    const ClusterJacobiPreconditionerParameters &p)
+  : Base(), parameters_(p) {}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::solve(const Vector& y, Vector &x) const {
+  // x_p = Lc^-1 y_p, then x_c = Ls^-1 (y_c - F x_p)
+  x = y;
+  for (size_t q = 0; q < points_.size(); ++q) {
+    auto xq = x.segment(starts_[points_[q]], dims_[points_[q]]);
+    pointFactors_[q].triangularView<Eigen::Lower>().solveInPlace(xq);
+  }
+  for (size_t c = 0; c < cameraBlocks_.size(); ++c)
+    for (const auto &q_block : cameraBlocks_[c])
+      x.segment(starts_[c], dims_[c]).noalias() -= q_block.second *
+          x.segment(starts_[points_[q_block.first]], dims_[points_[q_block.first]]);
+  for (size_t k = 0; k < clusters_.size(); ++k) {
+    Vector r(clusterFactors_[k].rows());
+    DenseIndex offset = 0;
+    for (size_t c : clusters_[k]) {
+      r.segment(offset, dims_[c]) = x.segment(starts_[c], dims_[c]);
+      offset += dims_[c];
+    }
+    clusterFactors_[k].triangularView<Eigen::Lower>().solveInPlace(r);
+    offset = 0;
+    for (size_t c : clusters_[k]) {
+      x.segment(starts_[c], dims_[c]) = r.segment(offset, dims_[c]);
+      offset += dims_[c];
+    }
+  }
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  // x_c = Ls^-T y_c, then x_p = Lc^-T (y_p - F' x_c)
+  x = y;
+  for (size_t k = 0; k < clusters_.size(); ++k) {
+    Vector r(clusterFactors_[k].rows());
+    DenseIndex offset = 0;
+    for (size_t c : clusters_[k]) {
+      r.segment(offset, dims_[c]) = x.segment(starts_[c], dims_[c]);
+      offset += dims_[c];
+    }
+    clusterFactors_[k].transpose().triangularView<Eigen::Upper>().solveInPlace(r);
+    offset = 0;
+    for (size_t c : clusters_[k]) {
+      x.segment(starts_[c], dims_[c]) = r.segment(offset, dims_[c]);
+      offset += dims_[c];
+    }
+  }
+  for (size_t c = 0; c < cameraBlocks_.size(); ++c)
+    for (const auto &q_block : cameraBlocks_[c])
+      x.segment(starts_[points_[q_block.first]], dims_[points_[q_block.first]])
+          .noalias() -= q_block.second.transpose() *
+                        x.segment(starts_[c], dims_[c]);
+  for (size_t q = 0; q < points_.size(); ++q) {
+    auto xq = x.segment(starts_[points_[q]], dims_[points_[q]]);
+    pointFactors_[q].transpose().triangularView<Eigen::Upper>().solveInPlace(xq);
+  }
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  starts_ = scalarStarts(keyInfo);
+  dims_ = keyInfo.colSpec();
+  const Ordering &ordering = keyInfo.ordering();
+  const LowerBlocks hessian = lowerHessianBlocks(gfg, keyInfo);
+  const size_t n = hessian.size();
+
+  /* factorize the point blocks C = Lc*Lc' */
+  vector<size_t> pointIndex(n, n);
+  points_.clear();
+  pointFactors_.clear();
+  for (size_t i = 0; i < n; ++i) {
+    if (!parameters_.pointTypes_.count(Symbol(ordering[i]).chr())) continue;
+    const Eigen::LLT<Matrix> llt(hessian[i].at(i));
+    if (llt.info() != Eigen::Success)
+      throw IndeterminantLinearSystemException(ordering[i]);
+    pointIndex[i] = points_.size();
+    points_.push_back(i);
+    pointFactors_.push_back(llt.matrixL());
+  }
+
+  /* F = E*Lc^-T, and the cameras with their block of F for each point */
+  cameraBlocks_.assign(n, vector<pair<size_t, Matrix> >());
+  vector<vector<pair<size_t, size_t> > > pointCameras(points_.size());
+  for (size_t j = 0; j < n; ++j)
+    for (const auto &i_block : hessian[j]) {
+      const size_t i = i_block.first;
+      const bool iPoint = pointIndex[i] < n, jPoint = pointIndex[j] < n;
+      if (iPoint == jPoint) continue;
+      const size_t c = iPoint ? j : i, q = iPoint ? pointIndex[i] : pointIndex[j];
+      const Matrix Et = iPoint ? i_block.second : Matrix(i_block.second.transpose());
+      pointCameras[q].emplace_back(c, cameraBlocks_[c].size());
+      cameraBlocks_[c].emplace_back(q,
+          pointFactors_[q].triangularView<Eigen::Lower>().solve(Et).transpose());
+    }
+
+  /* group the cameras into clusters by visibility */
+  vector<size_t> clusterOf(n, n);
+  clusters_.clear();
+  for (size_t c = 0; c < n; ++c) {
+    if (pointIndex[c] < n || clusterOf[c] < n) continue;
+    vector<size_t> members(1, c);
+    clusterOf[c] = clusters_.size();
+    while (members.size() < parameters_.clusterSize_) {
+      map<size_t, size_t> sharedPoints;
+      for (size_t m : members)
+        for (const auto &q_block : cameraBlocks_[m])
+          for (const auto &camera : pointCameras[q_block.first])
+            if (clusterOf[camera.first] == n) ++sharedPoints[camera.first];
+      size_t best = n, mostShared = 0;
+      for (const auto &camera_count : sharedPoints)
+        if (camera_count.second > mostShared) {
+          best = camera_count.first;
+          mostShared = camera_count.second;
+        }
+      if (best == n) break;
+      clusterOf[best] = clusters_.size();
+      members.push_back(best);
+    }
+    clusters_.push_back(members);
+  }
+
+  /* factorize the cluster blocks of S = B - F*F' */
+  clusterFactors_.clear();
+  for (size_t k = 0; k < clusters_.size(); ++k) {
+    const vector<size_t> &members = clusters_[k];
+    map<size_t, DenseIndex> offsets;
+    DenseIndex dim = 0;
+    for (size_t c : members) {
+      offsets[c] = dim;
+      dim += dims_[c];
+    }
+    Matrix S = Matrix::Zero(dim, dim);
+    for (size_t a : members)
+      for (const auto &i_block : hessian[a]) {
+        const auto i = offsets.find(i_block.first);
+        if (i == offsets.end()) continue;
+        S.block(i->second, offsets[a], dims_[i_block.first], dims_[a]) +=
+            i_block.second;
+        if (i_block.first != a)
+          S.block(offsets[a], i->second, dims_[a], dims_[i_block.first]) +=
+              i_block.second.transpose();
+      }
+    for (size_t a : members)
+      for (const auto &q_block : cameraBlocks_[a])
+        for (const auto &camera : pointCameras[q_block.first]) {
+          if (clusterOf[camera.first] != k) continue;
+          const Matrix &Fb = cameraBlocks_[camera.first][camera.second].second;
+          S.block(offsets[a], offsets[camera.first], dims_[a],
+                  dims_[camera.first]).noalias() -= q_block.second * Fb.transpose();
+        }
+    const Eigen::LLT<Matrix> llt(S);
+    if (llt.info() != Eigen::Success)
+      throw IndeterminantLinearSystemException(ordering[members.front()]);
+    clusterFactors_.push_back(llt.matrixL());
+  }
+}
+
 /***************************************************************************************/
 boost::shared_ptr<Preconditioner> createPreconditioner(
     const boost::shared_ptr<PreconditionerParameters> params) {
@@ -191,6 +526,14 @@ boost::shared_ptr<Preconditioner> createPreconditioner(
   } else if (dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(
                  params)) {
     return boost::make_shared<BlockJacobiPreconditioner>();
+  } else if (auto incompleteCholesky = dynamic_pointer_cast<
+                 BlockIncompleteCholeskyPreconditionerParameters>(params)) {
+    return boost::make_shared<BlockIncompleteCholeskyPreconditioner>(
+        *incompleteCholesky);
+  } else if (auto clusterJacobi =
+                 dynamic_pointer_cast<ClusterJacobiPreconditionerParameters>(
+                     params)) {
+    return boost::make_shared<ClusterJacobiPreconditioner>(*clusterJacobi);
   } else if (auto subgraph =
                  dynamic_pointer_cast<SubgraphPreconditionerParameters>(
                      params)) {
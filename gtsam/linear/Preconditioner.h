@@ -8,11 +8,15 @@
 
 #pragma once
 
+#include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
 #include <boost/shared_ptr.hpp>
 #include <iosfwd>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -153,6 +157,124 @@ protected:
   size_t nnz_;
 };
 
+/*******************************************************************************************/
+struct GTSAM_EXPORT BlockIncompleteCholeskyPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<BlockIncompleteCholeskyPreconditionerParameters> shared_ptr;
+
+  size_t fillLevel_;  ///< Keep fill up to this level, 0 keeps only the Hessian structure
+
+  BlockIncompleteCholeskyPreconditionerParameters(size_t fillLevel = 0)
+      : Base(), fillLevel_(fillLevel) {}
+  virtual ~BlockIncompleteCholeskyPreconditionerParameters() {}
+
+  virtual void print(std::ostream &os) const;
+};
+
+/*******************************************************************************************/
+/**
+ * Block incomplete Cholesky preconditioner IC(k): a Cholesky factorization
+ * M = L*L^T of the Hessian on its block structure, with one block per
+ * variable, that only keeps the fill-in blocks up to level k. Blocks of the
+ * Hessian have level 0, and eliminating variable j creates fill with level
+ * level(i,j) + level(l,j) + 1 in block (i,l). A large fill level is an exact
+ * block Cholesky factorization in the KeyInfo ordering. If the incomplete
+ * factorization breaks down, it is repeated on the Hessian with its diagonal
+ * scaled up by an increasing shift.
+ */
+class GTSAM_EXPORT BlockIncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  BlockIncompleteCholeskyPreconditioner(
+      const BlockIncompleteCholeskyPreconditionerParameters &p =
+          BlockIncompleteCholeskyPreconditionerParameters());
+  virtual ~BlockIncompleteCholeskyPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const;
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    );
+
+  /// Number of blocks in the strictly lower part of L
+  size_t nrOffDiagonalBlocks() const;
+
+  /// Diagonal shift that was needed to complete the factorization
+  double shift() const { return shift_; }
+
+protected:
+  BlockIncompleteCholeskyPreconditionerParameters parameters_;
+  std::vector<size_t> starts_;  ///< Scalar offset of each variable
+  std::vector<Matrix> diagonal_;  ///< Lower-triangular diagonal blocks of L
+  std::vector<std::vector<std::pair<size_t, Matrix> > > columns_;  ///< Blocks below the diagonal, by column
+  double shift_;
+};
+
+/*******************************************************************************************/
+struct GTSAM_EXPORT ClusterJacobiPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  typedef boost::shared_ptr<ClusterJacobiPreconditionerParameters> shared_ptr;
+
+  std::set<unsigned char> pointTypes_;  ///< Symbol characters of the eliminated variables
+  size_t clusterSize_;  ///< Maximum number of cameras per cluster, 1 is Schur-Jacobi
+
+  ClusterJacobiPreconditionerParameters(size_t clusterSize = 1)
+      : Base(), pointTypes_{'l'}, clusterSize_(clusterSize) {}
+  virtual ~ClusterJacobiPreconditionerParameters() {}
+
+  virtual void print(std::ostream &os) const;
+};
+
+/*******************************************************************************************/
+/**
+ * Schur complement preconditioner for bundle adjustment. Variables whose
+ * Symbol character is one of the point types are points, all others are
+ * cameras. With the points eliminated first, the Hessian factors as
+ *   [C E'; E B] = [Lc 0; F Ls] * [Lc' F'; 0 Ls']
+ * with C = Lc*Lc', F = E*Lc^-T and the reduced camera system
+ * S = B - E*C^-1*E' = Ls*Ls'. The preconditioner uses this factorization
+ * with S replaced by its cluster-Jacobi approximation: the dense blocks of S
+ * within clusters of cameras, and zero between clusters. With a cluster size
+ * of 1 this is the Schur-Jacobi preconditioner. Larger clusters group
+ * cameras by visibility: each cluster grows with the camera that shares the
+ * most points with it. Blocks between points are ignored, so points should
+ * only be connected to cameras.
+ */
+class GTSAM_EXPORT ClusterJacobiPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+
+  ClusterJacobiPreconditioner(
+      const ClusterJacobiPreconditionerParameters &p =
+          ClusterJacobiPreconditionerParameters());
+  virtual ~ClusterJacobiPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  virtual void solve(const Vector& y, Vector &x) const;
+  virtual void transposeSolve(const Vector& y, Vector& x) const;
+  virtual void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    );
+
+  /// The clusters of cameras, as positions in the KeyInfo ordering
+  const std::vector<std::vector<size_t> >& clusters() const { return clusters_; }
+
+protected:
+  ClusterJacobiPreconditionerParameters parameters_;
+  std::vector<size_t> starts_, dims_;  ///< Scalar offset and dimension of each variable
+  std::vector<size_t> points_;   ///< Positions of the points
+  std::vector<Matrix> pointFactors_;  ///< Lower Cholesky factor Lc of each point block
+  std::vector<std::vector<std::pair<size_t, Matrix> > > cameraBlocks_;  ///< Blocks of F in the row of each variable, by index in points_
+  std::vector<std::vector<size_t> > clusters_;  ///< Camera positions in each cluster
+  std::vector<Matrix> clusterFactors_;  ///< Lower Cholesky factor Ls of each cluster block of S
+};
+
 /*********************************************************************************************/
 /* factory method to create preconditioners */
 boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<PreconditionerParameters> parameters);
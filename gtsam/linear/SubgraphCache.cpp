@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SubgraphCache.cpp
+ * @brief   Subgraph selection and elimination structure kept across linear solves
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/SubgraphCache.h>
+#include <gtsam/linear/GaussianEliminationTree.h>
+#include <gtsam/base/timing.h>
+
+namespace gtsam {
+
+/* ************************************************************************* */
+SubgraphCache::SubgraphCache() : nrReused_(0), nrBuilt_(0) {}
+
+/* ************************************************************************* */
+SubgraphCache::~SubgraphCache() {}
+
+/* ************************************************************************* */
+const Subgraph& SubgraphCache::subgraph(const GaussianFactorGraph& graph,
+                                        const SubgraphBuilderParameters& p) {
+  if (sameStructure(graph, p)) {
+    ++nrReused_;
+    return *subgraph_;
+  }
+
+  gttic(SubgraphCache_build);
+  clear();
+  const SubgraphBuilder builder(p);
+  subgraph_ = builder(graph);
+  parameters_ = p;
+
+  signature_ = GraphStructureSignature(graph);
+  ++nrBuilt_;
+  return *subgraph_;
+}
+
+/* ************************************************************************* */
+GaussianBayesNet::shared_ptr SubgraphCache::eliminate(const GaussianFactorGraph& subgraphFactors,
+                                                      const Ordering& ordering,
+                                                      const Eliminate& function) {
+  if (!eliminationTree_ || ordering != treeOrdering_) {
+    gttic(SubgraphCache_eliminationTree);
+    std::unique_ptr<GaussianEliminationTree> eliminationTree(
+        new GaussianEliminationTree(subgraphFactors, variableIndex(subgraphFactors), ordering));
+    factorIndices_ = internal::detachTreeFactors(*eliminationTree, subgraphFactors);
+    eliminationTree_ = std::move(eliminationTree);
+    treeOrdering_ = ordering;
+  }
+  gttic(SubgraphCache_eliminate);
+  return internal::eliminateTreeWith(*eliminationTree_, subgraphFactors, factorIndices_,
+                                     function);
+}
+
+/* ************************************************************************* */
+GaussianBayesNet::shared_ptr SubgraphCache::eliminate(const GaussianFactorGraph& subgraphFactors,
+                                                      const Eliminate& function) {
+  const VariableIndex& index = variableIndex(subgraphFactors);
+  if (!ordering_)
+    ordering_ = Ordering::Colamd(index);
+  return eliminate(subgraphFactors, *ordering_, function);
+}
+
+/* ************************************************************************* */
+void SubgraphCache::clear() {
+  signature_.clear();
+  subgraph_.reset();
+  variableIndex_.reset();
+  ordering_.reset();
+  eliminationTree_.reset();
+  treeOrdering_.clear();
+  factorIndices_.clear();
+}
+
+/* ************************************************************************* */
+bool SubgraphCache::sameStructure(const GaussianFactorGraph& graph,
+                                  const SubgraphBuilderParameters& p) const {
+  if (!subgraph_)
+    return false;
+  if (p.skeletonType != parameters_.skeletonType ||
+      p.skeletonWeight != parameters_.skeletonWeight ||
+      p.augmentationWeight != parameters_.augmentationWeight ||
+      p.augmentationFactor != parameters_.augmentationFactor)
+    return false;
+  return signature_.matches(graph);
+}
+
+/* ************************************************************************* */
+const VariableIndex& SubgraphCache::variableIndex(const GaussianFactorGraph& subgraphFactors) {
+  if (!variableIndex_)
+    variableIndex_ = VariableIndex(subgraphFactors);
+  return *variableIndex_;
+}
+
+}
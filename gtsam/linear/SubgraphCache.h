@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SubgraphCache.h
+ * @brief   Subgraph selection and elimination structure kept across linear solves
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/SubgraphBuilder.h>
+#include <gtsam/linear/GaussianBayesNet.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/GraphStructureSignature.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/VariableIndex.h>
+
+#include <boost/optional.hpp>
+
+#include <memory>
+
+namespace gtsam {
+
+  // Forward declarations
+  class GaussianEliminationTree;
+
+  /**
+   * Keeps the subgraph selected by a SubgraphBuilder, and the symbolic data needed to eliminate
+   * the subgraph factors, between linear solves.  The subgraph, the VariableIndex of the subgraph
+   * factors, their COLAMD ordering if one is needed, and their elimination tree, are only
+   * recomputed when the graph does not have the same structure as the one of the previous call,
+   * i.e., the same keys in the same factors at the same positions, or when the builder
+   * parameters change.  This is the case for
+   * the linear graphs of successive iterations of the nonlinear optimizers, for which only the
+   * numerical factorization of the subgraph then needs to be repeated.
+   *
+   * With edge weights that depend on the numerical values (RHS_2NORM, LHS_FNORM) or are random,
+   * the reused subgraph is the one selected for the first graph, which is still a valid
+   * subgraph for the later ones.
+   */
+  class GTSAM_EXPORT SubgraphCache
+  {
+  public:
+    typedef GaussianFactorGraph::Eliminate Eliminate;
+
+    /** Construct with an empty cache */
+    SubgraphCache();
+
+    ~SubgraphCache();
+
+    /** The subgraph of \c graph selected by a SubgraphBuilder with parameters \c p, reused from
+     *  the previous call if \c graph has the same structure and \c p has not changed. */
+    const Subgraph& subgraph(const GaussianFactorGraph& graph,
+                             const SubgraphBuilderParameters& p);
+
+    /** Eliminate the factors selected by the cached subgraph, as returned by buildFactorSubgraph
+     *  or splitFactorGraph, with \c ordering.  The VariableIndex and the elimination tree of these
+     *  factors are reused, the latter as long as \c ordering does not change. */
+    GaussianBayesNet::shared_ptr eliminate(const GaussianFactorGraph& subgraphFactors,
+                                           const Ordering& ordering,
+                                           const Eliminate& function = EliminateQR);
+
+    /** Eliminate the factors selected by the cached subgraph with a COLAMD ordering, which is
+     *  computed once for each subgraph. */
+    GaussianBayesNet::shared_ptr eliminate(const GaussianFactorGraph& subgraphFactors,
+                                           const Eliminate& function = EliminateQR);
+
+    /** The number of calls to subgraph() that reused the cached subgraph */
+    size_t nrReused() const { return nrReused_; }
+
+    /** The number of calls to subgraph() that built a new subgraph */
+    size_t nrBuilt() const { return nrBuilt_; }
+
+    /** Forget the cached subgraph */
+    void clear();
+
+  private:
+    /// Whether \c graph has the same structure as the cached one, and \c p the same parameters
+    bool sameStructure(const GaussianFactorGraph& graph,
+                       const SubgraphBuilderParameters& p) const;
+
+    /// The VariableIndex of \c subgraphFactors, computed once for each subgraph
+    const VariableIndex& variableIndex(const GaussianFactorGraph& subgraphFactors);
+
+    GraphStructureSignature signature_; ///< Of the graph the subgraph was built for
+    SubgraphBuilderParameters parameters_; ///< The parameters the subgraph was built with
+    boost::optional<Subgraph> subgraph_;
+    boost::optional<VariableIndex> variableIndex_; ///< Of the subgraph factors
+    boost::optional<Ordering> ordering_; ///< COLAMD ordering of the subgraph factors
+    std::unique_ptr<GaussianEliminationTree> eliminationTree_; ///< Of the subgraph factors, without factors
+    Ordering treeOrdering_; ///< The ordering eliminationTree_ was built with
+    FastVector<size_t> factorIndices_; ///< The index of each factor of eliminationTree_
+    size_t nrReused_;
+    size_t nrBuilt_;
+  };
+
+}
@@ -18,16 +18,20 @@
 #include <gtsam/linear/SubgraphPreconditioner.h>
 
 #include <gtsam/linear/SubgraphBuilder.h>
+#include <gtsam/linear/SubgraphCache.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/TaskGroup.h>
 #include <gtsam/base/types.h>
 #include <gtsam/base/Vector.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <algorithm>
 #include <stdexcept>
+#include <unordered_map>
 
 using std::cout;
 using std::endl;
@@ -36,6 +40,9 @@ using std::ostream;
 
 namespace gtsam {
 
+// Conditionals per parallel task in solve and transposeSolve
+static const size_t kGrainSize = 64;
+
 /* ************************************************************************* */
 static Vector getSubvector(const Vector &src, const KeyInfo &keyInfo,
                            const KeyVector &keys) {
@@ -93,13 +100,16 @@ static GaussianFactorGraph::shared_ptr convertToJacobianFactors(
 
 /* ************************************************************************* */
 SubgraphPreconditioner::SubgraphPreconditioner(const SubgraphPreconditionerParameters &p) :
-         parameters_(p) {}
+         parameters_(p),
+         cache_(p.cache ? p.cache : boost::make_shared<SubgraphCache>()) {}
 
 /* ************************************************************************* */
 SubgraphPreconditioner::SubgraphPreconditioner(const sharedFG& Ab2,
     const sharedBayesNet& Rc1, const sharedValues& xbar, const SubgraphPreconditionerParameters &p) :
         Ab2_(convertToJacobianFactors(*Ab2)), Rc1_(Rc1), xbar_(xbar),
-        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p) {
+        b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p),
+        cache_(p.cache ? p.cache : boost::make_shared<SubgraphCache>()) {
+  computeLevels();
 }
 
 /* ************************************************************************* */
@@ -201,23 +211,57 @@ void SubgraphPreconditioner::print(const std::string& s) const {
 }
 
 /*****************************************************************************/
-void SubgraphPreconditioner::solve(const Vector &y, Vector &x) const {
-  assert(x.size() == y.size());
+void SubgraphPreconditioner::computeLevels() {
+  const size_t n = Rc1_->size();
+
+  /* find the conditional of each variable */
+  std::unordered_map<Key, size_t> conditionalOf;
+  for (size_t i = 0; i < n; ++i)
+    for (auto it = (*Rc1_)[i]->beginFrontals(); it != (*Rc1_)[i]->endFrontals(); ++it)
+      conditionalOf[*it] = i;
+
+  /* parents are eliminated later, so their depth is known when going backwards */
+  children_.assign(n, {});
+  vector<size_t> depth(n, 0);
+  size_t maxDepth = 0;
+  for (size_t i = n; i-- > 0;) {
+    const auto &cg = (*Rc1_)[i];
+    for (auto it = cg->beginParents(); it != cg->endParents(); ++it) {
+      const size_t parent = conditionalOf.at(*it);
+      children_[parent].emplace_back(i, it - cg->begin());
+      depth[i] = std::max(depth[i], depth[parent] + 1);
+    }
+    maxDepth = std::max(maxDepth, depth[i]);
+  }
 
-  /* back substitute */
-  for (const auto &cg : boost::adaptors::reverse(*Rc1_)) {
-    /* collect a subvector of x that consists of the parents of cg (S) */
-    const KeyVector parentKeys(cg->beginParents(), cg->endParents());
-    const KeyVector frontalKeys(cg->beginFrontals(), cg->endFrontals());
-    const Vector xParent = getSubvector(x, keyInfo_, parentKeys);
-    const Vector rhsFrontal = getSubvector(y, keyInfo_, frontalKeys);
+  levels_.assign(n ? maxDepth + 1 : 0, {});
+  for (size_t i = 0; i < n; ++i)
+    levels_[depth[i]].push_back(i);
+}
 
-    /* compute the solution for the current pivot */
-    const Vector solFrontal = cg->R().triangularView<Eigen::Upper>().solve(
-        rhsFrontal - cg->S() * xParent);
+/*****************************************************************************/
+void SubgraphPreconditioner::solve(const Vector &y, Vector &x) const {
+  assert(x.size() == y.size());
 
-    /* assign subvector of sol to the frontal variables */
-    setSubvector(solFrontal, keyInfo_, frontalKeys, x);
+  /* back substitute, from the roots down: the parents of a level are all solved */
+  for (const auto &level : levels_) {
+    ParallelFor(0, level.size(), kGrainSize, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        const auto &cg = (*Rc1_)[level[i]];
+        /* collect a subvector of x that consists of the parents of cg (S) */
+        const KeyVector parentKeys(cg->beginParents(), cg->endParents());
+        const KeyVector frontalKeys(cg->beginFrontals(), cg->endFrontals());
+        const Vector xParent = getSubvector(x, keyInfo_, parentKeys);
+        const Vector rhsFrontal = getSubvector(y, keyInfo_, frontalKeys);
+
+        /* compute the solution for the current pivot */
+        const Vector solFrontal = cg->R().triangularView<Eigen::Upper>().solve(
+            rhsFrontal - cg->S() * xParent);
+
+        /* assign subvector of sol to the frontal variables */
+        setSubvector(solFrontal, keyInfo_, frontalKeys, x);
+      }
+    });
   }
 }
 
@@ -227,44 +271,56 @@ void SubgraphPreconditioner::transposeSolve(const Vector &y, Vector &x) const {
   assert(x.size() == y.size());
   std::copy(y.data(), y.data() + y.rows(), x.data());
 
-  /* in place back substitute */
-  for (const auto &cg : *Rc1_) {
-    const KeyVector frontalKeys(cg->beginFrontals(), cg->endFrontals());
-    const Vector rhsFrontal = getSubvector(x, keyInfo_, frontalKeys);
-    const Vector solFrontal =
-        cg->R().transpose().triangularView<Eigen::Lower>().solve(
-            rhsFrontal);
-
-    // Check for indeterminant solution
-    if (solFrontal.hasNaN())
-      throw IndeterminantLinearSystemException(cg->keys().front());
-
-    /* assign subvector of sol to the frontal variables */
-    setSubvector(solFrontal, keyInfo_, frontalKeys, x);
-
-    /* substract from parent variables */
-    for (auto it = cg->beginParents(); it != cg->endParents(); it++) {
-      const KeyInfoEntry &entry = keyInfo_.find(*it)->second;
-      Eigen::Map<Vector> rhsParent(x.data() + entry.start, entry.dim, 1);
-      rhsParent -= Matrix(cg->getA(it)).transpose() * solFrontal;
-    }
+  /* in place back substitute, from the leaves up: the children of a level are all solved */
+  for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+    ParallelFor(0, level->size(), kGrainSize, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        const size_t index = (*level)[i];
+        const auto &cg = (*Rc1_)[index];
+
+        /* substract the solved children from the frontal variables */
+        for (const auto &child : children_[index]) {
+          const auto &childCg = (*Rc1_)[child.first];
+          const KeyVector childKeys(childCg->beginFrontals(), childCg->endFrontals());
+          const Vector solChild = getSubvector(x, keyInfo_, childKeys);
+          const auto it = childCg->begin() + child.second;
+          const KeyInfoEntry &entry = keyInfo_.find(*it)->second;
+          Eigen::Map<Vector> rhsFrontal(x.data() + entry.start, entry.dim, 1);
+          rhsFrontal -= Matrix(childCg->getA(it)).transpose() * solChild;
+        }
+
+        const KeyVector frontalKeys(cg->beginFrontals(), cg->endFrontals());
+        const Vector rhsFrontal = getSubvector(x, keyInfo_, frontalKeys);
+        const Vector solFrontal =
+            cg->R().transpose().triangularView<Eigen::Lower>().solve(
+                rhsFrontal);
+
+        // Check for indeterminant solution
+        if (solFrontal.hasNaN())
+          throw IndeterminantLinearSystemException(cg->keys().front());
+
+        /* assign subvector of sol to the frontal variables */
+        setSubvector(solFrontal, keyInfo_, frontalKeys, x);
+      }
+    });
   }
 }
 
 /*****************************************************************************/
 void SubgraphPreconditioner::build(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
 {
-  /* identify the subgraph structure */
-  const SubgraphBuilder builder(parameters_.builderParams);
-  auto subgraph = builder(gfg);
+  /* identify the subgraph structure, reused if gfg has the same structure as before */
+  const Subgraph &subgraph = cache_->subgraph(gfg, parameters_.builderParams);
 
   keyInfo_ = keyInfo;
 
   /* build factor subgraph */
   GaussianFactorGraph::shared_ptr gfg_subgraph = buildFactorSubgraph(gfg, subgraph, true);
 
-  /* factorize and cache BayesNet */
-  Rc1_ = gfg_subgraph->eliminateSequential();
+  /* factorize and cache BayesNet, with the ordering of the cached subgraph */
+  Rc1_ = cache_->eliminate(*gfg_subgraph,
+      EliminationTraits<GaussianFactorGraph>::DefaultEliminate);
+  computeLevels();
 }
 
 /*****************************************************************************/
@@ -27,12 +27,15 @@
 #include <boost/shared_ptr.hpp>
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace gtsam {
 
   // Forward declarations
   class GaussianBayesNet;
   class GaussianFactorGraph;
+  class SubgraphCache;
   class VectorValues;
 
   struct GTSAM_EXPORT SubgraphPreconditionerParameters : public PreconditionerParameters {
@@ -40,6 +43,11 @@ namespace gtsam {
     SubgraphPreconditionerParameters(const SubgraphBuilderParameters &p = SubgraphBuilderParameters())
       : builderParams(p) {}
     SubgraphBuilderParameters builderParams;
+
+    /// If set, the subgraph cache shared by all preconditioners created from these parameters,
+    /// e.g. by PCGSolver in each iteration of a nonlinear optimizer.  Otherwise each
+    /// preconditioner only reuses the subgraph across its own calls to build().
+    boost::shared_ptr<SubgraphCache> cache;
   };
 
   /**
@@ -66,6 +74,18 @@ namespace gtsam {
 
     KeyInfo keyInfo_;
     SubgraphPreconditionerParameters parameters_;
+    boost::shared_ptr<SubgraphCache> cache_; ///< Subgraph kept between calls to build()
+
+    /// Indices of the conditionals of Rc1 by depth, roots first.  The conditionals of one depth
+    /// do not depend on each other, so solve and transposeSolve handle them in parallel.
+    std::vector<std::vector<size_t> > levels_;
+
+    /// For each conditional of Rc1, the conditionals that have one of its frontal variables as
+    /// parent, with the position of that parent in their keys
+    std::vector<std::vector<std::pair<size_t, size_t> > > children_;
+
+    /// Compute levels_ and children_ for Rc1
+    void computeLevels();
 
   public:
 
@@ -20,6 +20,7 @@
 #include <gtsam/linear/SubgraphSolver.h>
 
 #include <gtsam/linear/SubgraphBuilder.h>
+#include <gtsam/linear/SubgraphCache.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/iterative-inl.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
@@ -45,6 +46,22 @@ SubgraphSolver::SubgraphSolver(const GaussianFactorGraph &Ab,
   pc_ = boost::make_shared<SubgraphPreconditioner>(Ab2, Rc1, xbar);
 }
 
+/**************************************************************************************************/
+// Taking system [A|b], with the subgraph structure kept in cache
+SubgraphSolver::SubgraphSolver(const GaussianFactorGraph &Ab,
+    const Parameters &parameters, const Ordering& ordering, SubgraphCache &cache) :
+    parameters_(parameters) {
+  GaussianFactorGraph::shared_ptr Ab1,Ab2;
+  std::tie(Ab1, Ab2) = splitFactorGraph(Ab, cache.subgraph(Ab, parameters_.builderParams));
+  if (parameters_.verbosity())
+    cout << "Split A into (A1) " << Ab1->size() << " and (A2) " << Ab2->size()
+         << " factors" << endl;
+
+  auto Rc1 = cache.eliminate(*Ab1, ordering, EliminateQR);
+  auto xbar = boost::make_shared<VectorValues>(Rc1->optimize());
+  pc_ = boost::make_shared<SubgraphPreconditioner>(Ab2, Rc1, xbar);
+}
+
 /**************************************************************************************************/
 // Taking eliminated tree [R1|c] and constraint graph [A2|b2]
 SubgraphSolver::SubgraphSolver(const GaussianBayesNet::shared_ptr &Rc1,
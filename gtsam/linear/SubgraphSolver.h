@@ -30,6 +30,7 @@ namespace gtsam {
 // Forward declarations
 class GaussianFactorGraph;
 class GaussianBayesNet;
+class SubgraphCache;
 class SubgraphPreconditioner;
 
 struct GTSAM_EXPORT SubgraphSolverParameters
@@ -93,6 +94,16 @@ class GTSAM_EXPORT SubgraphSolver : public IterativeSolver {
   SubgraphSolver(const GaussianFactorGraph &A, const Parameters &parameters,
                  const Ordering &ordering);
 
+  /**
+   * The same as above, but the spanning tree selected for a previous graph with
+   * the same structure is taken from \c cache, together with the VariableIndex
+   * of A1, so that only the numerical factorization of A1 is repeated. This is
+   * used by the nonlinear optimizers, whose linear graphs have the same
+   * structure in every iteration.
+   */
+  SubgraphSolver(const GaussianFactorGraph &A, const Parameters &parameters,
+                 const Ordering &ordering, SubgraphCache &cache);
+
   /**
    * The user specifies the subgraph part and the constraints part.
    * May throw exception if A1 is underdetermined. An ordering is required to
@@ -0,0 +1,566 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalCholesky.cpp
+ * @brief   Supernodal sparse Cholesky factorization of a GaussianFactorGraph
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/SupernodalCholesky.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/TaskGroup.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+// Subtrees whose estimated factorization cost is below this number of flops
+// are factorized serially within a single task.
+static const double parallelFlopsThreshold = 1e5;
+}
+
+/* ************************************************************************* */
+SupernodalCholesky::SupernodalCholesky(const GaussianFactorGraph& gfg,
+                                       const Ordering& ordering,
+                                       Precision precision)
+    : ordering_(ordering), precision_(precision), factorized_(false) {
+  gttic(SupernodalCholesky_symbolic);
+  symbolic(gfg);
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::symbolic(const GaussianFactorGraph& gfg) {
+  const size_t n = ordering_.size();
+  for (size_t i = 0; i < n; ++i) positions_[ordering_[i]] = i;
+
+  // Collect dimensions, and for each variable the factors in which it is the
+  // first variable in the ordering
+  dims_.assign(n, 0);
+  vector<vector<size_t> > factorPositions;
+  factorPositions.reserve(gfg.size());
+  vector<vector<size_t> > variableFactors(n);
+  for (const auto& factor : gfg) {
+    if (!factor) continue;
+    vector<size_t> positions;
+    positions.reserve(factor->size());
+    for (auto it = factor->begin(); it != factor->end(); ++it) {
+      const auto found = positions_.find(*it);
+      if (found == positions_.end())
+        throw std::invalid_argument(
+            "SupernodalCholesky: the ordering is missing a key of the graph");
+      positions.push_back(found->second);
+      dims_[found->second] = factor->getDim(it);
+    }
+    std::sort(positions.begin(), positions.end());
+    for (size_t p : positions) variableFactors[p].push_back(factorPositions.size());
+    factorPositions.push_back(std::move(positions));
+  }
+  for (size_t i = 0; i < n; ++i)
+    if (dims_[i] == 0)
+      throw std::invalid_argument(
+          "SupernodalCholesky: the ordering contains a key not in the graph");
+
+  columnStarts_.resize(n + 1);
+  columnStarts_[0] = 0;
+  for (size_t i = 0; i < n; ++i) columnStarts_[i + 1] = columnStarts_[i] + dims_[i];
+
+  // Elimination tree of A'A, computed directly from the factors (Liu's
+  // algorithm with path compression, as in CSparse's cs_etree)
+  vector<size_t> parent(n, n), ancestor(n, n);
+  vector<size_t> previous(factorPositions.size(), n);
+  for (size_t k = 0; k < n; ++k) {
+    for (size_t f : variableFactors[k]) {
+      size_t i = previous[f];
+      while (i != n && i != k) {
+        const size_t next = ancestor[i];
+        ancestor[i] = k;
+        if (next == n) parent[i] = k;
+        i = next;
+      }
+      previous[f] = k;
+    }
+  }
+
+  // Block structure of each column of L: the union of the structure of the
+  // factors starting at that variable and of the children's structure.
+  vector<vector<size_t> > structure(n);
+  vector<vector<size_t> > etreeChildren(n);
+  for (size_t j = 0; j < n; ++j)
+    if (parent[j] != n) etreeChildren[parent[j]].push_back(j);
+  vector<size_t> mark(n, n);
+  for (size_t j = 0; j < n; ++j) {
+    vector<size_t>& s = structure[j];
+    mark[j] = j;
+    for (size_t f : variableFactors[j]) {
+      const vector<size_t>& positions = factorPositions[f];
+      if (positions.front() != j) continue;
+      for (size_t p : positions)
+        if (mark[p] != j) {
+          mark[p] = j;
+          s.push_back(p);
+        }
+    }
+    for (size_t c : etreeChildren[j])
+      for (size_t p : structure[c])
+        if (mark[p] != j) {
+          mark[p] = j;
+          s.push_back(p);
+        }
+    std::sort(s.begin(), s.end());
+  }
+
+  // Group consecutive variables into fundamental supernodes: j joins the
+  // supernode of j-1 if j-1 is its only child and their structure is nested.
+  supernodes_.clear();
+  supernodeOf_.resize(n);
+  for (size_t j = 0; j < n; ++j) {
+    if (j > 0 && parent[j - 1] == j && etreeChildren[j].size() == 1 &&
+        structure[j - 1].size() == structure[j].size() + 1) {
+      Supernode& node = supernodes_.back();
+      node.nrVariables += 1;
+      node.nrColumns += dims_[j];
+    } else {
+      Supernode node;
+      node.firstVariable = j;
+      node.nrVariables = 1;
+      node.nrColumns = dims_[j];
+      supernodes_.push_back(node);
+    }
+    supernodeOf_[j] = supernodes_.size() - 1;
+  }
+
+  const size_t N = supernodes_.size();
+  for (size_t s = 0; s < N; ++s) {
+    Supernode& node = supernodes_[s];
+    node.rowVariables.swap(structure[node.firstVariable + node.nrVariables - 1]);
+    node.rowOffsets.resize(node.rowVariables.size());
+    node.nrRows = node.nrColumns;
+    for (size_t t = 0; t < node.rowVariables.size(); ++t) {
+      node.rowOffsets[t] = node.nrRows;
+      node.nrRows += dims_[node.rowVariables[t]];
+    }
+    node.parent = node.rowVariables.empty() ? N : supernodeOf_[node.rowVariables.front()];
+    if (node.parent != N) supernodes_[node.parent].children.push_back(s);
+    // Every supernode met in the structure receives an update from this one
+    size_t last = N;
+    for (size_t v : node.rowVariables) {
+      const size_t target = supernodeOf_[v];
+      if (target != last) supernodes_[target].updaters.push_back(s);
+      last = target;
+    }
+  }
+
+  // Post-order of the supernodal tree, and estimated cost of each subtree
+  postOrder_.clear();
+  postOrder_.reserve(N);
+  subtreeBegin_.assign(N, 0);
+  subtreeFlops_.assign(N, 0.0);
+  vector<pair<size_t, size_t> > stack;
+  for (size_t r = 0; r < N; ++r) {
+    if (supernodes_[r].parent != N) continue;
+    subtreeBegin_[r] = postOrder_.size();
+    stack.push_back(make_pair(r, 0));
+    while (!stack.empty()) {
+      pair<size_t, size_t>& top = stack.back();
+      const Supernode& node = supernodes_[top.first];
+      if (top.second < node.children.size()) {
+        const size_t c = node.children[top.second++];
+        subtreeBegin_[c] = postOrder_.size();
+        stack.push_back(make_pair(c, 0));
+      } else {
+        postOrder_.push_back(top.first);
+        stack.pop_back();
+      }
+    }
+  }
+  for (size_t s = 0; s < N; ++s) {
+    const Supernode& node = supernodes_[s];
+    const double nc = double(node.nrColumns), nb = double(node.nrRows - node.nrColumns);
+    subtreeFlops_[s] += nc * nc * nc / 3.0 + nb * nc * nc + nb * nb * nc;
+    if (node.parent != N) subtreeFlops_[node.parent] += subtreeFlops_[s];
+  }
+}
+
+/* ************************************************************************* */
+DenseIndex SupernodalCholesky::panelRow(const Supernode& node,
+                                        size_t variable) const {
+  if (variable < node.firstVariable) return -1;
+  if (variable < node.firstVariable + node.nrVariables)
+    return columnStarts_[variable] - columnStarts_[node.firstVariable];
+  const auto it = std::lower_bound(node.rowVariables.begin(),
+                                   node.rowVariables.end(), variable);
+  if (it == node.rowVariables.end() || *it != variable) return -1;
+  return node.rowOffsets[it - node.rowVariables.begin()];
+}
+
+/* ************************************************************************* */
+bool SupernodalCholesky::sameStructure(const GaussianFactorGraph& gfg) const {
+  vector<bool> seen(ordering_.size(), false);
+  for (const auto& factor : gfg) {
+    if (!factor) continue;
+    for (auto it = factor->begin(); it != factor->end(); ++it) {
+      const auto found = positions_.find(*it);
+      if (found == positions_.end() || dims_[found->second] != factor->getDim(it))
+        return false;
+      seen[found->second] = true;
+      for (auto jt = factor->begin(); jt != it; ++jt) {
+        const size_t p = found->second, q = positions_.at(*jt);
+        const size_t row = std::max(p, q), col = std::min(p, q);
+        if (panelRow(supernodes_[supernodeOf_[col]], row) < 0) return false;
+      }
+    }
+  }
+  return std::find(seen.begin(), seen.end(), false) == seen.end();
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::locate(size_t row, size_t col, size_t& s, DenseIndex& panelRow,
+                                DenseIndex& panelCol) const {
+  s = supernodeOf_[col];
+  const Supernode& node = supernodes_[s];
+  panelRow = this->panelRow(node, row);
+  if (panelRow < 0)
+    throw std::invalid_argument(
+        "SupernodalCholesky: graph structure differs from the analyzed one");
+  panelCol = columnStarts_[col] - columnStarts_[node.firstVariable];
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::assemble(const GaussianFactorGraph& gfg, vector<PANEL>& panels) {
+  gttic(SupernodalCholesky_assemble);
+  typedef typename PANEL::Scalar Scalar;
+  panels.resize(supernodes_.size());
+  for (size_t s = 0; s < supernodes_.size(); ++s)
+    panels[s].setZero(supernodes_[s].nrRows, supernodes_[s].nrColumns);
+  rhs_.setZero(columnStarts_.back());
+
+  // The contribution of each factor is computed in double precision, and
+  // accumulated directly in the panels
+  vector<size_t> positions;
+  vector<DenseIndex> offsets;
+  Matrix whitened;  // Whitened [A b] of a Jacobian factor, re-used across factors
+  size_t s;
+  DenseIndex row, col;
+  for (const auto& factor : gfg) {
+    if (!factor) continue;
+    positions.clear();
+    offsets.clear();
+    DenseIndex offset = 0;
+    for (auto it = factor->begin(); it != factor->end(); ++it) {
+      const auto found = positions_.find(*it);
+      if (found == positions_.end() || dims_[found->second] != factor->getDim(it))
+        throw std::invalid_argument(
+            "SupernodalCholesky: graph structure differs from the analyzed one");
+      positions.push_back(found->second);
+      offsets.push_back(offset);
+      offset += dims_[found->second];
+    }
+    const size_t n = positions.size();
+
+    if (const auto jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor)) {
+      // A'A and A'b from the whitened Jacobian
+      if (jacobian->isConstrained())
+        throw std::invalid_argument(
+            "SupernodalCholesky: constrained noise models are not supported");
+      const VerticalBlockMatrix& Ab = jacobian->matrixObject();
+      const DenseIndex rows = Ab.rows(), cols = Ab.cols();
+      if (whitened.rows() < rows || whitened.cols() < cols)
+        whitened.resize(std::max(rows, DenseIndex(whitened.rows())),
+                        std::max(cols, DenseIndex(whitened.cols())));
+      Eigen::Block<Matrix> wAb = whitened.topLeftCorner(rows, cols);
+      wAb = Ab.full();
+      if (jacobian->get_model()) jacobian->get_model()->WhitenInPlace(wAb);
+      for (size_t a = 0; a < n; ++a) {
+        const size_t pa = positions[a];
+        const DenseIndex da = dims_[pa];
+        const auto Aa = wAb.middleCols(offsets[a], da);
+        rhs_.segment(columnStarts_[pa], da).noalias() += Aa.transpose() * wAb.col(cols - 1);
+        for (size_t b = 0; b < n; ++b) {
+          const size_t pb = positions[b];
+          if (pa < pb) continue;
+          locate(pa, pb, s, row, col);
+          panels[s].block(row, col, da, dims_[pb]) +=
+              (Aa.transpose() * wAb.middleCols(offsets[b], dims_[pb])).template cast<Scalar>();
+        }
+      }
+    } else if (const auto hessian = boost::dynamic_pointer_cast<HessianFactor>(factor)) {
+      // The blocks of the information matrix, of which only the upper triangle is stored.
+      // Only the lower triangle of the diagonal blocks of L is ever read.
+      const SymmetricBlockMatrix& info = hessian->info();
+      for (size_t a = 0; a < n; ++a) {
+        const size_t pa = positions[a];
+        const DenseIndex da = dims_[pa];
+        rhs_.segment(columnStarts_[pa], da) += info.aboveDiagonalBlock(a, n);
+        for (size_t b = 0; b < n; ++b) {
+          const size_t pb = positions[b];
+          if (pa < pb) continue;
+          locate(pa, pb, s, row, col);
+          auto target = panels[s].block(row, col, da, dims_[pb]);
+          if (a == b)
+            target.template triangularView<Eigen::Lower>() +=
+                info.diagonalBlock(a).nestedExpression().transpose().template cast<Scalar>();
+          else if (a < b)
+            target += info.aboveDiagonalBlock(a, b).template cast<Scalar>();
+          else
+            target += info.aboveDiagonalBlock(b, a).transpose().template cast<Scalar>();
+        }
+      }
+    } else {
+      const Matrix info = factor->augmentedInformation();
+      const DenseIndex last = info.cols() - 1;
+      for (size_t a = 0; a < n; ++a) {
+        const size_t pa = positions[a];
+        const DenseIndex da = dims_[pa];
+        rhs_.segment(columnStarts_[pa], da) += info.block(offsets[a], last, da, 1);
+        for (size_t b = 0; b < n; ++b) {
+          const size_t pb = positions[b];
+          if (pa < pb) continue;
+          locate(pa, pb, s, row, col);
+          panels[s].block(row, col, da, dims_[pb]) +=
+              info.block(offsets[a], offsets[b], da, dims_[pb]).template cast<Scalar>();
+        }
+      }
+    }
+  }
+}
+
+/* ************************************************************************* */
+template <class PANEL>
+void SupernodalCholesky::factorizeSupernode(vector<PANEL>& panels, size_t s) {
+  const Supernode& node = supernodes_[s];
+  PANEL& panel = panels[s];
+  const size_t end = node.firstVariable + node.nrVariables;
+
+  // Left-looking: apply the updates of all descendants whose structure
+  // intersects the columns of this supernode, L_s -= L_d(below) * L_d(s)'
+  for (size_t d : node.updaters) {
+    const Supernode& descendant = supernodes_[d];
+    const PANEL& source = panels[d];
+    const vector<size_t>& rows = descendant.rowVariables;
+    const size_t k0 = std::lower_bound(rows.begin(), rows.end(), node.firstVariable) - rows.begin();
+    const size_t k1 = std::lower_bound(rows.begin() + k0, rows.end(), end) - rows.begin();
+    const DenseIndex r0 = descendant.rowOffsets[k0];
+    const DenseIndex r1 = k1 < rows.size() ? descendant.rowOffsets[k1] : descendant.nrRows;
+    const PANEL update = source.bottomRows(descendant.nrRows - r0) *
+                         source.middleRows(r0, r1 - r0).transpose();
+
+    // Scatter the lower triangle of the update into the panel
+    for (size_t t = k0; t < rows.size(); ++t) {
+      const size_t v = rows[t];
+      const DenseIndex row = panelRow(node, v);
+      for (size_t u = k0; u < k1 && u <= t; ++u) {
+        const size_t w = rows[u];
+        const DenseIndex col = columnStarts_[w] - columnStarts_[node.firstVariable];
+        panel.block(row, col, dims_[v], dims_[w]) -= update.block(
+            descendant.rowOffsets[t] - r0, descendant.rowOffsets[u] - r0, dims_[v], dims_[w]);
+      }
+    }
+  }
+
+  // Factorize the diagonal block in place, L_diag * L_diag' = A_diag
+  Eigen::Ref<PANEL> diagonal = panel.topRows(node.nrColumns);
+  Eigen::LLT<Eigen::Ref<PANEL>, Eigen::Lower> llt(diagonal);
+  if (llt.info() != Eigen::Success)
+    throw IndeterminantLinearSystemException(ordering_[node.firstVariable]);
+
+  // Below-diagonal part, L_below = A_below * inv(L_diag')
+  if (node.nrRows > node.nrColumns) {
+    auto below = panel.bottomRows(node.nrRows - node.nrColumns);
+    diagonal.template triangularView<Eigen::Lower>().transpose()
+        .template solveInPlace<Eigen::OnTheRight>(below);
+  }
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::factorizeSupernode(size_t s) {
+  if (precision_ == SINGLE)
+    factorizeSupernode(panelsSingle_, s);
+  else
+    factorizeSupernode(panels_, s);
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::factorizeSubtree(size_t s) {
+  for (size_t i = subtreeBegin_[s]; postOrder_[i] != s; ++i)
+    factorizeSupernode(postOrder_[i]);
+  factorizeSupernode(s);
+}
+
+/* ************************************************************************* */
+void SupernodalCholesky::factorize(const GaussianFactorGraph& gfg) {
+  gttic(SupernodalCholesky_factorize);
+  factorized_ = false;
+  // Only the panels of the requested precision are assembled and kept
+  if (precision_ == SINGLE) {
+    assemble(gfg, panelsSingle_);
+    vector<Matrix>().swap(panels_);
+  } else {
+    assemble(gfg, panels_);
+    vector<Eigen::MatrixXf>().swap(panelsSingle_);
+  }
+
+  const size_t N = supernodes_.size();
+  if (TaskGroup::MaxConcurrency() <= 1) {
+    // Children always precede their parents
+    for (size_t s = 0; s < N; ++s) factorizeSupernode(s);
+    factorized_ = true;
+    return;
+  }
+
+  // Each task either factorizes a small subtree serially or a single large
+  // supernode. A large supernode is scheduled once all its children are done.
+  TbbOpenMPMixedScope threadLimiter;
+  TaskGroup group;
+  std::vector<std::atomic<size_t> > pending(N);
+  for (size_t s = 0; s < N; ++s)
+    pending[s] = supernodes_[s].children.size();
+  const auto small = [&](size_t s) {
+    return subtreeFlops_[s] < parallelFlopsThreshold;
+  };
+  std::function<void(size_t)> run = [&](size_t s) {
+    if (small(s))
+      factorizeSubtree(s);
+    else
+      factorizeSupernode(s);
+    const size_t p = supernodes_[s].parent;
+    if (p != N && --pending[p] == 0) group.run([&run, p] { run(p); });
+  };
+  for (size_t s = 0; s < N; ++s) {
+    const size_t p = supernodes_[s].parent;
+    const bool taskRoot = small(s) && (p == N || !small(p));
+    const bool largeLeaf = !small(s) && supernodes_[s].children.empty();
+    if (taskRoot || largeLeaf) group.run([&run, s] { run(s); });
+  }
+  group.wait();
+
+  factorized_ = true;
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::optimize() const {
+  gttic(SupernodalCholesky_optimize);
+  if (!factorized_)
+    throw std::runtime_error("SupernodalCholesky::optimize: call factorize first");
+  return toVectorValues(solve(rhs_));
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::optimize(const GaussianFactorGraph& gfg,
+                                          size_t maxRefinements,
+                                          double tolerance) const {
+  gttic(SupernodalCholesky_optimize);
+  if (!factorized_)
+    throw std::runtime_error("SupernodalCholesky::optimize: call factorize first");
+
+  Vector x = solve(rhs_);
+  if (precision_ == DOUBLE)
+    return toVectorValues(x);
+
+  // Iterative refinement, x += inv(L L') * A'(b - A x), with the residual in
+  // double precision
+  gttic(SupernodalCholesky_refine);
+  const double threshold = tolerance * rhs_.norm();
+  double previousNorm = std::numeric_limits<double>::infinity();
+  for (size_t k = 0; k < maxRefinements; ++k) {
+    const VectorValues gradient = gfg.gradient(toVectorValues(x));
+    Vector residual(x.size());
+    for (size_t i = 0; i < ordering_.size(); ++i)
+      residual.segment(columnStarts_[i], dims_[i]) = -gradient.at(ordering_[i]);
+    const double norm = residual.norm();
+    if (norm <= threshold || norm >= previousNorm)
+      break;
+    previousNorm = norm;
+    x += solve(residual);
+  }
+  return toVectorValues(x);
+}
+
+/* ************************************************************************* */
+Vector SupernodalCholesky::solve(const Vector& rhs) const {
+  if (precision_ == SINGLE) {
+    Eigen::VectorXf x = rhs.cast<float>();
+    substitute(panelsSingle_, x);
+    return x.cast<double>();
+  }
+  Vector x = rhs;
+  substitute(panels_, x);
+  return x;
+}
+
+/* ************************************************************************* */
+template <class PANEL, class VECTOR>
+void SupernodalCholesky::substitute(const vector<PANEL>& panels, VECTOR& x) const {
+  // Forward substitution, L y = A'b
+  for (size_t s = 0; s < supernodes_.size(); ++s) {
+    const Supernode& node = supernodes_[s];
+    const PANEL& panel = panels[s];
+    auto xs = x.segment(columnStarts_[node.firstVariable], node.nrColumns);
+    panel.topRows(node.nrColumns).template triangularView<Eigen::Lower>().solveInPlace(xs);
+    if (node.nrRows > node.nrColumns) {
+      const VECTOR update = panel.bottomRows(node.nrRows - node.nrColumns) * xs;
+      for (size_t t = 0; t < node.rowVariables.size(); ++t) {
+        const size_t v = node.rowVariables[t];
+        x.segment(columnStarts_[v], dims_[v]) -=
+            update.segment(node.rowOffsets[t] - node.nrColumns, dims_[v]);
+      }
+    }
+  }
+
+  // Back substitution, L' x = y
+  for (size_t s = supernodes_.size(); s-- > 0;) {
+    const Supernode& node = supernodes_[s];
+    const PANEL& panel = panels[s];
+    auto xs = x.segment(columnStarts_[node.firstVariable], node.nrColumns);
+    if (node.nrRows > node.nrColumns) {
+      VECTOR gathered(node.nrRows - node.nrColumns);
+      for (size_t t = 0; t < node.rowVariables.size(); ++t) {
+        const size_t v = node.rowVariables[t];
+        gathered.segment(node.rowOffsets[t] - node.nrColumns, dims_[v]) =
+            x.segment(columnStarts_[v], dims_[v]);
+      }
+      xs.noalias() -= panel.bottomRows(node.nrRows - node.nrColumns).transpose() * gathered;
+    }
+    panel.topRows(node.nrColumns).template triangularView<Eigen::Lower>().transpose().solveInPlace(xs);
+  }
+}
+
+/* ************************************************************************* */
+VectorValues SupernodalCholesky::toVectorValues(const Vector& x) const {
+  VectorValues result;
+  for (size_t i = 0; i < ordering_.size(); ++i)
+    result.emplace(ordering_[i], x.segment(columnStarts_[i], dims_[i]));
+  return result;
+}
+
+/* ************************************************************************* */
+size_t SupernodalCholesky::nnz() const {
+  size_t result = 0;
+  for (const Supernode& node : supernodes_) {
+    const size_t nc = node.nrColumns, nb = node.nrRows - node.nrColumns;
+    result += nc * (nc + 1) / 2 + nb * nc;
+  }
+  return result;
+}
+
+}  // namespace gtsam
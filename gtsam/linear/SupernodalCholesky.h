@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SupernodalCholesky.h
+ * @brief   Supernodal sparse Cholesky factorization of a GaussianFactorGraph
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/FastMap.h>
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gtsam {
+
+class GaussianFactorGraph;
+
+/**
+ * Supernodal sparse Cholesky solver for the normal equations of a
+ * GaussianFactorGraph. This is the engine behind the CHOLMOD linear solver
+ * type in NonlinearOptimizerParams.
+ *
+ * The work is split into a symbolic and a numeric phase. The constructor
+ * analyzes the graph structure for a given ordering: it computes the block
+ * elimination tree, the block structure of the factor L, and groups
+ * consecutive variables with nested structure into (fundamental) supernodes.
+ * factorize() then assembles the Hessian of a graph with that structure
+ * directly into the dense supernode panels and factorizes them left-looking,
+ * using dense BLAS-3 kernels (LLT, triangular solve, and matrix products) per
+ * supernode. Independent subtrees of the supernodal tree are factorized in
+ * parallel in a TaskGroup; the result does not depend on the schedule.
+ * optimize() performs the forward and back substitutions.
+ *
+ * Because the symbolic phase only depends on the graph structure, one
+ * SupernodalCholesky can be re-used to factorize successive linearizations
+ * of the same nonlinear factor graph; NonlinearOptimizer keeps one between
+ * iterations for as long as sameStructure() holds.
+ *
+ * With SINGLE precision, the contribution of each factor is computed in
+ * double and accumulated directly into float panels, which are factorized and
+ * substituted in float. This halves their memory traffic and doubles the SIMD
+ * width of the dense kernels. optimize(gfg) then recovers double precision accuracy by iterative
+ * refinement: the residual of the normal equations is computed in double
+ * from the factors of gfg, and the correction is solved with the single
+ * precision factor. This is the engine behind the MIXED_PRECISION_CHOLESKY
+ * linear solver type.
+ *
+ * Constrained noise models are not supported, use a QR-based solver for
+ * those.
+ */
+class GTSAM_EXPORT SupernodalCholesky {
+ public:
+  typedef boost::shared_ptr<SupernodalCholesky> shared_ptr;
+
+  /// Scalar type in which the factor L is computed and stored
+  enum Precision { DOUBLE, SINGLE };
+
+  /// Symbolic description of one supernode
+  struct Supernode {
+    size_t firstVariable;  ///< Position in the ordering of the first variable
+    size_t nrVariables;    ///< Number of consecutive variables in the supernode
+    DenseIndex nrColumns;  ///< Total scalar dimension of the variables
+    std::vector<size_t> rowVariables;  ///< Sorted below-diagonal variable positions
+    std::vector<DenseIndex> rowOffsets;  ///< Row in the panel of each row variable
+    DenseIndex nrRows;     ///< Total number of rows of the panel
+    size_t parent;         ///< Parent supernode, or nrSupernodes() for a root
+    std::vector<size_t> children;  ///< Child supernodes in the supernodal tree
+    std::vector<size_t> updaters;  ///< Descendants that contribute an update
+  };
+
+ private:
+  Ordering ordering_;                      ///< Elimination ordering
+  FastMap<Key, size_t> positions_;         ///< Position of each key in ordering_
+  std::vector<DenseIndex> dims_;           ///< Dimension of each variable
+  std::vector<DenseIndex> columnStarts_;   ///< Scalar offset of each variable
+  std::vector<size_t> supernodeOf_;        ///< Supernode containing each variable
+  std::vector<Supernode> supernodes_;      ///< Supernodes, children before parents
+  std::vector<size_t> postOrder_;          ///< Post-order of the supernodal tree
+  std::vector<size_t> subtreeBegin_;       ///< Index in postOrder_ where a subtree starts
+  std::vector<double> subtreeFlops_;       ///< Estimated flops to factorize a subtree
+
+  Precision precision_;
+  std::vector<Matrix> panels_;  ///< Dense panels [L_diag; L_below] per supernode
+  std::vector<Eigen::MatrixXf> panelsSingle_;  ///< The panels with SINGLE precision
+  Vector rhs_;                  ///< Assembled information vector A'b
+  bool factorized_;
+
+ public:
+  /// @name Constructors
+  /// @{
+
+  /**
+   * Perform the symbolic analysis of a graph for a given elimination
+   * ordering, which has to contain all keys of the graph.
+   */
+  SupernodalCholesky(const GaussianFactorGraph& gfg, const Ordering& ordering,
+                     Precision precision = DOUBLE);
+
+  /// @}
+  /// @name Numeric factorization and solving
+  /// @{
+
+  /**
+   * Assemble and factorize the normal equations of a graph with the same
+   * structure as the one passed to the constructor. Throws
+   * IndeterminantLinearSystemException if the system is not positive
+   * definite, and std::invalid_argument on a structure mismatch.
+   */
+  void factorize(const GaussianFactorGraph& gfg);
+
+  /// Solve the factorized system, i.e., return the minimizer of |Ax-b|^2
+  VectorValues optimize() const;
+
+  /**
+   * Solve the factorized system, and refine the solution until the residual
+   * A'(b-Ax) of the factorized graph \c gfg, computed in double precision,
+   * is below \c tolerance times |A'b|, or at most \c maxRefinements times.
+   * Refinement stops early if the residual stops decreasing. With DOUBLE
+   * precision this is the same as optimize().
+   */
+  VectorValues optimize(const GaussianFactorGraph& gfg,
+                        size_t maxRefinements = 10,
+                        double tolerance = 1e-12) const;
+
+  /// @}
+  /// @name Standard interface
+  /// @{
+
+  /// Return the elimination ordering
+  const Ordering& ordering() const { return ordering_; }
+
+  /// Return the precision of the factor L
+  Precision precision() const { return precision_; }
+
+  /// Return the number of supernodes
+  size_t nrSupernodes() const { return supernodes_.size(); }
+
+  /// Access a supernode
+  const Supernode& supernode(size_t i) const { return supernodes_[i]; }
+
+  /// Return the number of non-zero scalar entries in the factor L
+  size_t nnz() const;
+
+  /// Check whether the structure of a graph matches the analyzed one
+  bool sameStructure(const GaussianFactorGraph& gfg) const;
+
+  /// @}
+
+ private:
+  void symbolic(const GaussianFactorGraph& gfg);
+  template <class PANEL>
+  void assemble(const GaussianFactorGraph& gfg, std::vector<PANEL>& panels);
+  void locate(size_t row, size_t col, size_t& s, DenseIndex& panelRow,
+              DenseIndex& panelCol) const;
+  void factorizeSupernode(size_t s);
+  void factorizeSubtree(size_t s);
+  template <class PANEL>
+  void factorizeSupernode(std::vector<PANEL>& panels, size_t s);
+  Vector solve(const Vector& rhs) const;
+  template <class PANEL, class VECTOR>
+  void substitute(const std::vector<PANEL>& panels, VECTOR& x) const;
+  VectorValues toVectorValues(const Vector& x) const;
+  DenseIndex panelRow(const Supernode& node, size_t variable) const;
+};
+
+}  // namespace gtsam
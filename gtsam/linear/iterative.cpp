@@ -20,6 +20,7 @@
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/FlatVectorValues.h>
 #include <gtsam/linear/IterativeSolver.h>
 
 #include <iostream>
@@ -61,16 +62,18 @@ namespace gtsam {
   }
 
   /* ************************************************************************* */
+  // The graph versions iterate on contiguous FlatVectorValues, so that the
+  // vector operations in CG are single loops that do not allocate.
   VectorValues steepestDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
-    return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
-        fg, x, parameters, true);
+    return conjugateGradients<GaussianFactorGraph, FlatVectorValues, Errors>(
+        fg, FlatVectorValues(x), parameters, true).vectorValues();
   }
 
   VectorValues conjugateGradientDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
-    return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
-        fg, x, parameters);
+    return conjugateGradients<GaussianFactorGraph, FlatVectorValues, Errors>(
+        fg, FlatVectorValues(x), parameters).vectorValues();
   }
 
 /* ************************************************************************* */
@@ -22,6 +22,8 @@
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <mutex>
+
 namespace gtsam
 {
   namespace internal
@@ -47,6 +49,9 @@ namespace gtsam
       struct OptimizeClique
       {
         VectorValues collectedResult;
+#ifndef GTSAM_USE_TBB
+        std::mutex collectedResultMutex; // Without TBB, VectorValues is not a concurrent container
+#endif
 
         OptimizeData operator()(
           const boost::shared_ptr<CLIQUE>& clique,
@@ -96,6 +101,9 @@ namespace gtsam
             if(solution.hasNaN()) throw IndeterminantLinearSystemException(c.keys().front());
 
             // Insert solution into a VectorValues
+#ifndef GTSAM_USE_TBB
+            std::lock_guard<std::mutex> lock(collectedResultMutex);
+#endif
             DenseIndex vectorPosition = 0;
             for(GaussianConditional::const_iterator frontal = c.beginFrontals(); frontal != c.endFrontals(); ++frontal) {
               VectorValues::const_iterator r =
@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBlockSparseRowMatrix.cpp
+ * @brief   Unit tests for the block sparse row Jacobian
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/BlockSparseRowMatrix.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+namespace {
+// Poses with 3-dimensional and landmarks with 2-dimensional variables, with
+// diagonal and constrained noise models
+GaussianFactorGraph createGraph() {
+  srand(7);
+  GaussianFactorGraph gfg;
+  gfg.add(X(0), I_3x3, Vector3(1.0, 2.0, 3.0),
+          noiseModel::Constrained::All(3));
+  for (size_t i = 0; i < 20; ++i) {
+    gfg.add(X(i), Matrix3::Random() + 2 * I_3x3, X(i + 1), -I_3x3,
+            Vector3::Random(),
+            noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3)));
+    gfg.add(X(i), Matrix23::Random(), L(i % 7), Matrix2::Random(),
+            Vector2::Random(), noiseModel::Isotropic::Sigma(2, 0.5));
+  }
+  return gfg;
+}
+}
+
+/* ************************************************************************* */
+TEST(BlockSparseRowMatrix, Products) {
+  const GaussianFactorGraph gfg = createGraph();
+  const KeyInfo keyInfo(gfg);
+  const BlockSparseRowMatrix bsr(gfg, keyInfo);
+  EXPECT_LONGS_EQUAL(gfg.size(), bsr.nrBlockRows());
+  EXPECT_LONGS_EQUAL(2 * gfg.size() - 1, bsr.blocks().size());
+  EXPECT(bsr.otherFactors().empty());
+
+  // The whitened augmented Jacobian in the order of the KeyInfo
+  const Matrix Ab = gfg.augmentedJacobian(keyInfo.ordering());
+  EXPECT(assert_equal(Ab, bsr.augmentedMatrix()));
+  const Matrix A = Ab.leftCols(Ab.cols() - 1);
+
+  const Vector x = Vector::Random(bsr.cols()), y = Vector::Random(bsr.rows());
+  Vector Ax(bsr.rows()), Aty(bsr.cols()), AtAx;
+  bsr.multiply(x, Ax);
+  EXPECT(assert_equal(Vector(A * x), Ax, 1e-9));
+  bsr.transposeMultiply(y, Aty);
+  EXPECT(assert_equal(Vector(A.transpose() * y), Aty, 1e-9));
+  bsr.multiplyHessian(x, AtAx, keyInfo);
+  EXPECT(assert_equal(Vector(A.transpose() * (A * x)), AtAx, 1e-9));
+  EXPECT(assert_equal(
+      Vector(-gfg.gradientAtZero().vector(keyInfo.ordering())),
+      bsr.negativeGradientAtZero(keyInfo), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(BlockSparseRowMatrix, OtherFactors) {
+  // HessianFactors are applied through the graph
+  GaussianFactorGraph gfg = createGraph();
+  gfg.push_back(boost::make_shared<HessianFactor>(
+      X(3), L(2), 4 * I_3x3, Matrix32::Ones(), Vector3(1.0, 0.0, -1.0),
+      3 * I_2x2, Vector2(0.5, 0.5), 1.0));
+  const KeyInfo keyInfo(gfg);
+  const BlockSparseRowMatrix bsr(gfg, keyInfo);
+  EXPECT_LONGS_EQUAL(1, bsr.otherFactors().size());
+
+  // Same as the products through the factors
+  const Vector x = Vector::Random(bsr.cols());
+  VectorValues expectedHx = keyInfo.x0();
+  gfg.multiplyHessianAdd(1.0, buildVectorValues(x, keyInfo), expectedHx);
+  Vector Hx;
+  bsr.multiplyHessian(x, Hx, keyInfo);
+  EXPECT(assert_equal(expectedHx.vector(keyInfo.ordering()), Hx, 1e-9));
+  EXPECT(assert_equal(
+      Vector(-gfg.gradientAtZero().vector(keyInfo.ordering())),
+      bsr.negativeGradientAtZero(keyInfo), 1e-9));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
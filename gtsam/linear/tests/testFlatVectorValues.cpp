@@ -0,0 +1,177 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testFlatVectorValues.cpp
+ * @brief   Unit tests for FlatVectorValues
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/FlatVectorValues.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/iterative.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/Testable.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+namespace {
+VectorValues createValues() {
+  VectorValues values;
+  values.emplace(2, Vector2(1.0, 2.0));
+  values.emplace(0, Vector3(3.0, 4.0, 5.0));
+  values.emplace(5, Vector1(6.0));
+  return values;
+}
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, basics) {
+  const VectorValues values = createValues();
+  FlatVectorValues actual(values);
+
+  // Keys are stored in key order, contiguously
+  EXPECT_LONGS_EQUAL(3, actual.size());
+  EXPECT_LONGS_EQUAL(6, actual.dim());
+  EXPECT_LONGS_EQUAL(2, actual.dim(2));
+  EXPECT(actual.exists(5));
+  EXPECT(!actual.exists(1));
+  EXPECT(KeyVector({0, 2, 5}) == actual.layout()->keys());
+  EXPECT(assert_equal((Vector(6) << 3, 4, 5, 1, 2, 6).finished(), actual.vector()));
+  EXPECT(assert_equal(Vector(Vector2(1.0, 2.0)), Vector(actual.at(2))));
+
+  // Writing through a view
+  actual[5] << 7.0;
+  EXPECT_DOUBLES_EQUAL(7.0, actual.vector()(5), 1e-9);
+  CHECK_EXCEPTION(actual.at(1), std::out_of_range);
+
+  // Round trip
+  actual.update(values);
+  EXPECT(assert_equal(values, actual.vectorValues()));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, SharedLayout) {
+  const VectorValues values = createValues();
+  const FlatVectorValues x(values);
+  const FlatVectorValues zero = FlatVectorValues::Zero(x);
+  EXPECT(zero.layout() == x.layout());
+  EXPECT_DOUBLES_EQUAL(0.0, zero.norm(), 1e-9);
+
+  // A separately constructed layout with the same structure also matches
+  const FlatVectorValues y(values);
+  EXPECT(y.layout() != x.layout());
+  EXPECT(y.hasSameStructure(x));
+
+  // A layout from an ordering stores keys in that order
+  const Ordering ordering(KeyVector{5, 2, 0});
+  const FlatVectorValues::LayoutPtr layout(
+      new FlatVectorValues::Layout(ordering, {{0, 3}, {2, 2}, {5, 1}}));
+  const FlatVectorValues z(values, layout);
+  EXPECT(assert_equal((Vector(6) << 6, 1, 2, 3, 4, 5).finished(), z.vector()));
+  EXPECT(!z.hasSameStructure(x));
+  EXPECT(assert_equal(values, z.vectorValues()));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, LinearAlgebra) {
+  const VectorValues values = createValues();
+  VectorValues other = createValues();
+  other *= 2.0;
+
+  const FlatVectorValues x(values);
+  const FlatVectorValues y(other, x.layout());
+
+  EXPECT_DOUBLES_EQUAL(values.dot(other), x.dot(y), 1e-9);
+  EXPECT_DOUBLES_EQUAL(values.norm(), x.norm(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(values.squaredNorm(), x.squaredNorm(), 1e-9);
+  EXPECT(assert_equal(values + other, (x + y).vectorValues()));
+  EXPECT(assert_equal(values - other, (x - y).vectorValues()));
+  EXPECT(assert_equal(3.0 * values, (3.0 * x).vectorValues()));
+
+  FlatVectorValues z = x;
+  z += y;
+  z -= x;
+  EXPECT(assert_equal(y, z));
+  z *= 0.5;
+  EXPECT(assert_equal(x, z));
+  axpy(2.0, x, z);
+  EXPECT(assert_equal(3.0 * x, z));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, ConjugateGradient) {
+  // Matrix-vector products on flat storage agree with VectorValues
+  auto model = noiseModel::Isotropic::Sigma(2, 0.5);
+  GaussianFactorGraph gfg;
+  gfg.add(X(0), I_2x2, Vector2(1.0, 2.0), model);
+  gfg.add(X(0), -I_2x2, X(1), 2 * I_2x2, Vector2(0.5, 0.5), model);
+  gfg.add(X(1), -I_2x2, X(2), I_2x2, Vector2(0.0, 1.0), model);
+
+  VectorValues x0;
+  x0.emplace(X(0), Vector2(0.1, 0.2));
+  x0.emplace(X(1), Vector2(0.3, 0.4));
+  x0.emplace(X(2), Vector2(0.5, 0.6));
+  const FlatVectorValues flat(x0);
+
+  EXPECT(assert_equal(gfg.gradient(x0), gfg.gradient(flat).vectorValues()));
+  const Errors e = gfg * x0;
+  EXPECT(assert_equal(e, gfg * flat));
+
+  VectorValues expected = x0;
+  gfg.transposeMultiplyAdd(0.5, e, expected);
+  FlatVectorValues actual = flat;
+  gfg.transposeMultiplyAdd(0.5, e, actual);
+  EXPECT(assert_equal(expected, actual.vectorValues()));
+
+  // CG on the graph converges to the direct solution
+  ConjugateGradientParameters parameters;
+  parameters.setEpsilon_abs(1e-12);
+  parameters.setEpsilon_rel(1e-12);
+  parameters.setMaxIterations(100);
+  EXPECT(assert_equal(gfg.optimize(), conjugateGradientDescent(gfg, x0, parameters), 1e-6));
+}
+
+/* ************************************************************************* */
+TEST(FlatVectorValues, multiplyHessianAdd) {
+  // Jacobian and Hessian factors give the same A'Ax as with VectorValues
+  auto model = noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0));
+  GaussianFactorGraph gfg;
+  gfg.add(X(0), I_2x2, Vector2(1.0, 2.0), model);
+  gfg.add(X(0), -I_2x2, X(1), 2 * I_2x2, Vector2(0.5, 0.5), model);
+  gfg.add(HessianFactor(JacobianFactor(X(1), -I_2x2, X(2),
+                                       (Matrix2() << 1.0, 2.0, 3.0, 4.0).finished(),
+                                       Vector2(0.0, 1.0), model)));
+
+  VectorValues x;
+  x.emplace(X(0), Vector2(0.1, 0.2));
+  x.emplace(X(1), Vector2(0.3, 0.4));
+  x.emplace(X(2), Vector2(0.5, 0.6));
+  const FlatVectorValues flat(x);
+
+  VectorValues expected = VectorValues::Zero(x);
+  gfg.multiplyHessianAdd(2.0, x, expected);
+  FlatVectorValues actual = FlatVectorValues::Zero(flat);
+  gfg.multiplyHessianAdd(2.0, flat, actual);
+  EXPECT(assert_equal(expected, actual.vectorValues()));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
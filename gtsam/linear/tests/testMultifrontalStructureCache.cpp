@@ -0,0 +1,118 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testMultifrontalStructureCache.cpp
+ * @brief   Unit tests for MultifrontalStructureCache
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/MultifrontalStructureCache.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/inference/inferenceExceptions.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+// A chain x0 - x1 - x2 - x3 - x4 with a prior on x0, with coefficients depending on s
+GaussianFactorGraph createChain(double s) {
+  const SharedDiagonal model = noiseModel::Isotropic::Sigma(2, 0.5);
+  GaussianFactorGraph graph;
+  graph.add(0, s * I_2x2, Vector2(1.0, s), model);
+  for (Key j = 0; j < 4; ++j)
+    graph.add(j, -s * I_2x2, j + 1, (Matrix2() << 1.0, s, 0.0, 2.0).finished(),
+              Vector2(s, 0.5 * j), model);
+  return graph;
+}
+
+const Ordering ordering = Ordering(KeyVector{4, 0, 2, 1, 3});
+}
+
+/* ************************************************************************* */
+TEST(MultifrontalStructureCache, Reuse) {
+  MultifrontalStructureCache cache;
+
+  const GaussianFactorGraph graph1 = createChain(1.0);
+  EXPECT(assert_equal(*graph1.eliminateMultifrontal(ordering), *cache.eliminate(graph1, ordering)));
+  EXPECT_LONGS_EQUAL(1, cache.nrBuilt());
+  EXPECT_LONGS_EQUAL(0, cache.nrReused());
+
+  // Same structure, other numbers
+  const GaussianFactorGraph graph2 = createChain(2.0);
+  EXPECT(assert_equal(*graph2.eliminateMultifrontal(ordering), *cache.eliminate(graph2, ordering)));
+  EXPECT_LONGS_EQUAL(1, cache.nrBuilt());
+  EXPECT_LONGS_EQUAL(1, cache.nrReused());
+
+  // The cache does not keep the factors
+  for (const GaussianFactor::shared_ptr& factor : graph2)
+    EXPECT_LONGS_EQUAL(1, factor.use_count());
+
+  // Another ordering
+  const Ordering colamd = Ordering::Colamd(graph2);
+  EXPECT(assert_equal(*graph2.eliminateMultifrontal(colamd), *cache.eliminate(graph2, colamd)));
+  EXPECT_LONGS_EQUAL(2, cache.nrBuilt());
+
+  // Another structure
+  GaussianFactorGraph graph3 = createChain(3.0);
+  graph3.add(0, I_2x2, 4, I_2x2, Vector2(0.1, 0.2), noiseModel::Unit::Create(2));
+  EXPECT(assert_equal(*graph3.eliminateMultifrontal(colamd), *cache.eliminate(graph3, colamd)));
+  EXPECT_LONGS_EQUAL(3, cache.nrBuilt());
+  EXPECT_LONGS_EQUAL(1, cache.nrReused());
+}
+
+/* ************************************************************************* */
+TEST(MultifrontalStructureCache, ComputedOrdering) {
+  MultifrontalStructureCache cache;
+  for (double s : {1.0, 2.0, 3.0}) {
+    const GaussianFactorGraph graph = createChain(s);
+    EXPECT(assert_equal(*graph.eliminateMultifrontal(), *cache.eliminate(graph, Ordering::COLAMD)));
+  }
+  EXPECT_LONGS_EQUAL(1, cache.nrBuilt());
+  EXPECT_LONGS_EQUAL(2, cache.nrReused());
+  EXPECT(assert_equal(Ordering::Colamd(createChain(1.0)), cache.ordering()));
+}
+
+/* ************************************************************************* */
+TEST(MultifrontalStructureCache, NullAndRepeatedFactors) {
+  MultifrontalStructureCache cache;
+  for (double s : {1.0, 2.0}) {
+    GaussianFactorGraph graph = createChain(s);
+    graph.push_back(GaussianFactor::shared_ptr());
+    graph.push_back(graph[2]);
+    EXPECT(assert_equal(*graph.eliminateMultifrontal(ordering), *cache.eliminate(graph, ordering)));
+  }
+  EXPECT_LONGS_EQUAL(1, cache.nrReused());
+
+  // A null factor in another place changes the structure
+  GaussianFactorGraph graph = createChain(1.0);
+  graph.push_back(graph[2]);
+  graph.push_back(GaussianFactor::shared_ptr());
+  EXPECT(assert_equal(*graph.eliminateMultifrontal(ordering), *cache.eliminate(graph, ordering)));
+  EXPECT_LONGS_EQUAL(2, cache.nrBuilt());
+}
+
+/* ************************************************************************* */
+TEST(MultifrontalStructureCache, IncompleteOrdering) {
+  MultifrontalStructureCache cache;
+  CHECK_EXCEPTION(cache.eliminate(createChain(1.0), Ordering(KeyVector{0, 1, 2})),
+                  InconsistentEliminationRequested);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
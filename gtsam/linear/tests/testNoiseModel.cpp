@@ -719,6 +719,81 @@ TEST(NoiseModel, NonDiagonalGaussian)
   }
 }
 
+/* ************************************************************************* */
+TEST(NoiseModel, WhitenSystems)
+{
+  // Four stacked 2x3 systems, with diagonal, isotropic, full, and robust noise models
+  Matrix2 R;
+  R << 2, 1, 0, 3;
+  const std::vector<SharedNoiseModel> models{
+      Diagonal::Sigmas(Vector2(0.5, 2.0)), Isotropic::Sigma(2, 0.1),
+      Gaussian::SqrtInformation(R),
+      Robust::Create(mEstimator::Huber::Create(1.0), Isotropic::Sigma(2, 0.5))};
+  Matrix A = Matrix::Random(8, 3);
+  Vector b = Vector::Random(8) * 10;
+
+  // Same as whitening each system on its own
+  Matrix expectedA = A;
+  Vector expectedb = b;
+  for (size_t i = 0; i < 4; ++i) {
+    Matrix Ai = A.middleRows(2 * i, 2);
+    Vector bi = b.segment(2 * i, 2);
+    models[i]->WhitenSystem(Ai, bi);
+    expectedA.middleRows(2 * i, 2) = Ai;
+    expectedb.segment(2 * i, 2) = bi;
+  }
+  Matrix actualA = A;
+  Vector actualb = b;
+  WhitenSystems(models, actualA, actualb);
+  EXPECT(assert_equal(expectedA, actualA));
+  EXPECT(assert_equal(expectedb, actualb));
+
+  // Residuals only
+  Vector expectedErrors = b;
+  for (size_t i = 0; i < 4; ++i)
+    expectedErrors.segment(2 * i, 2) = models[i]->whiten(b.segment(2 * i, 2));
+  Vector actualErrors = b;
+  WhitenSystems(models, actualErrors);
+  EXPECT(assert_equal(expectedErrors, actualErrors));
+
+  // A single model shared by all systems
+  const std::vector<SharedNoiseModel> shared{models[0]};
+  actualA = A;
+  actualb = b;
+  WhitenSystems(shared, actualA, actualb);
+  EXPECT(assert_equal(Matrix(Vector4(2, 0.5, 2, 0.5).replicate(2, 1).asDiagonal() * A), actualA));
+  Matrix sharedA = A;
+  Vector sharedb = b;
+  WhitenSystems(*models[0], sharedA, sharedb);
+  EXPECT(assert_equal(actualA, sharedA));
+  EXPECT(assert_equal(actualb, sharedb));
+
+  // Runs of systems that share a model
+  const std::vector<SharedNoiseModel> runs{models[0], models[0], models[1], models[2],
+                                           models[2], models[3], models[1], models[1]};
+  Matrix runsA = Matrix::Random(16, 3);
+  Vector runsb = Vector::Random(16) * 10;
+  expectedA = runsA;
+  expectedb = runsb;
+  for (size_t i = 0; i < 8; ++i) {
+    Matrix Ai = runsA.middleRows(2 * i, 2);
+    Vector bi = runsb.segment(2 * i, 2);
+    runs[i]->WhitenSystem(Ai, bi);
+    expectedA.middleRows(2 * i, 2) = Ai;
+    expectedb.segment(2 * i, 2) = bi;
+  }
+  WhitenSystems(runs, runsA, runsb);
+  EXPECT(assert_equal(expectedA, runsA));
+  EXPECT(assert_equal(expectedb, runsb));
+
+  // Mismatched sizes are detected
+  Matrix threeA = A.topRows(6);
+  Vector threeb = b.head(6);
+  CHECK_EXCEPTION(WhitenSystems(models, threeA, threeb), std::invalid_argument);
+  CHECK_EXCEPTION(WhitenSystems(*Isotropic::Sigma(3, 1.0), actualA, actualb),
+                  std::invalid_argument);
+}
+
 /* ************************************************************************* */
 int main() {  TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
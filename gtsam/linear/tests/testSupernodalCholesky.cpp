@@ -0,0 +1,173 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testSupernodalCholesky.cpp
+ * @brief   Unit tests for the supernodal sparse Cholesky solver
+ * @date    Oct 2026
+ */
+
+#include <gtsam/linear/SupernodalCholesky.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/inference/Symbol.h>
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+namespace {
+// A grid of 3-dimensional variables with random between factors and a prior
+GaussianFactorGraph createGrid(size_t N) {
+  srand(42);
+  auto model = noiseModel::Isotropic::Sigma(3, 0.5);
+  GaussianFactorGraph gfg;
+  gfg.add(X(0), I_3x3, Vector3(1.0, 2.0, 3.0), model);
+  for (size_t i = 0; i < N; ++i)
+    for (size_t j = 0; j < N; ++j) {
+      const size_t k = i * N + j;
+      if (j + 1 < N)
+        gfg.add(X(k), Matrix3::Random() - 2 * I_3x3, X(k + 1), I_3x3,
+                Vector3::Random(), model);
+      if (i + 1 < N)
+        gfg.add(X(k), Matrix3::Random() + 2 * I_3x3, X(k + N), -I_3x3,
+                Vector3::Random(), model);
+    }
+  return gfg;
+}
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, Supernodes) {
+  // Variables with nested structure are grouped into supernodes
+  GaussianFactorGraph gfg;
+  auto model = noiseModel::Isotropic::Sigma(2, 0.1);
+  gfg.add(X(0), I_2x2, Vector2(1.0, 0.0), model);
+  gfg.add(X(0), I_2x2, X(1), -I_2x2, X(2), 2 * I_2x2, Vector2(0.5, 0.5), model);
+  gfg.add(X(1), I_2x2, Vector2(0.0, 1.0), model);
+  gfg.add(X(2), -I_2x2, X(3), I_2x2, Vector2(1.0, 0.5), model);
+  for (size_t i = 3; i < 6; ++i)
+    gfg.add(X(i), -I_2x2, X(i + 1), I_2x2, Vector2(1.0, 0.5), model);
+
+  Ordering ordering;
+  for (size_t i = 0; i <= 6; ++i) ordering.push_back(X(i));
+
+  // {x0,x1}, then a chain which is not supernodal, except for the root
+  SupernodalCholesky cholesky(gfg, ordering);
+  EXPECT_LONGS_EQUAL(5, cholesky.nrSupernodes());
+  EXPECT_LONGS_EQUAL(4, cholesky.supernode(0).nrColumns);
+  EXPECT_LONGS_EQUAL(6, cholesky.supernode(0).nrRows);
+  EXPECT_LONGS_EQUAL(4, cholesky.supernode(4).nrColumns);
+  EXPECT_LONGS_EQUAL(4, cholesky.supernode(4).nrRows);
+  EXPECT_LONGS_EQUAL(1, cholesky.supernode(0).parent);
+  EXPECT_LONGS_EQUAL(5, cholesky.supernode(4).parent);
+  cholesky.factorize(gfg);
+  EXPECT(assert_equal(gfg.optimize(), cholesky.optimize(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, Grid) {
+  const GaussianFactorGraph gfg = createGrid(6);
+  const VectorValues expected = gfg.optimize();
+
+  // Several orderings give different supernode partitions, same solution
+  const Ordering colamd = Ordering::Colamd(gfg);
+  SupernodalCholesky cholesky(gfg, colamd);
+  EXPECT(cholesky.nrSupernodes() > 1);
+  EXPECT(cholesky.nrSupernodes() < colamd.size());
+  cholesky.factorize(gfg);
+  EXPECT(assert_equal(expected, cholesky.optimize(), 1e-7));
+
+  const Ordering metis = Ordering::Metis(gfg);
+  SupernodalCholesky nested(gfg, metis);
+  nested.factorize(gfg);
+  EXPECT(assert_equal(expected, nested.optimize(), 1e-7));
+
+  const Ordering natural = Ordering::Natural(gfg);
+  SupernodalCholesky banded(gfg, natural);
+  banded.factorize(gfg);
+  EXPECT(assert_equal(expected, banded.optimize(), 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, Refactorize) {
+  // The symbolic analysis is re-used for a graph with the same structure
+  GaussianFactorGraph gfg = createGrid(4);
+  const Ordering ordering = Ordering::Colamd(gfg);
+  SupernodalCholesky cholesky(gfg, ordering);
+  cholesky.factorize(gfg);
+  EXPECT(assert_equal(gfg.optimize(), cholesky.optimize(), 1e-7));
+
+  GaussianFactorGraph scaled;
+  for (const auto& factor : gfg)
+    scaled.push_back(boost::make_shared<HessianFactor>(*factor));
+  scaled.add(X(5), 2 * I_3x3, Vector3(0.1, 0.2, 0.3));
+  EXPECT(cholesky.sameStructure(scaled));
+  cholesky.factorize(scaled);
+  EXPECT(assert_equal(scaled.optimize(), cholesky.optimize(), 1e-7));
+
+  // A graph with a different structure is detected
+  GaussianFactorGraph different = gfg;
+  different.add(X(100), I_3x3, Vector3::Zero());
+  EXPECT(!cholesky.sameStructure(different));
+  CHECK_EXCEPTION(cholesky.factorize(different), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, MixedPrecision) {
+  const GaussianFactorGraph gfg = createGrid(6);
+  const VectorValues expected = gfg.optimize();
+  const Ordering ordering = Ordering::Colamd(gfg);
+
+  // Without refinement, the single precision solution is only roughly accurate
+  SupernodalCholesky cholesky(gfg, ordering, SupernodalCholesky::SINGLE);
+  EXPECT(cholesky.precision() == SupernodalCholesky::SINGLE);
+  cholesky.factorize(gfg);
+  EXPECT(assert_equal(expected, cholesky.optimize(), 1e-3));
+  EXPECT(!expected.equals(cholesky.optimize(gfg, 0), 1e-9));
+
+  // Iterative refinement recovers double precision accuracy
+  EXPECT(assert_equal(expected, cholesky.optimize(gfg), 1e-9));
+
+  // Refactorizing a graph with the same structure, here of Hessian factors
+  GaussianFactorGraph hessians;
+  for (const auto& factor : gfg)
+    hessians.push_back(boost::make_shared<HessianFactor>(*factor));
+  cholesky.factorize(hessians);
+  EXPECT(assert_equal(expected, cholesky.optimize(hessians), 1e-9));
+
+  // With double precision, no refinement is needed
+  SupernodalCholesky exact(gfg, ordering);
+  exact.factorize(gfg);
+  EXPECT(assert_equal(exact.optimize(), exact.optimize(gfg)));
+}
+
+/* ************************************************************************* */
+TEST(SupernodalCholesky, Indeterminant) {
+  // X(2) is not constrained
+  GaussianFactorGraph gfg;
+  auto model = noiseModel::Isotropic::Sigma(2, 0.1);
+  gfg.add(X(0), I_2x2, Vector2(1.0, 0.0), model);
+  gfg.add(X(0), -I_2x2, X(1), I_2x2, Vector2(1.0, 0.5), model);
+  gfg.add(X(2), Matrix2::Zero(), Vector2(0.0, 0.0), model);
+
+  SupernodalCholesky cholesky(gfg, Ordering::Colamd(gfg));
+  CHECK_EXCEPTION(cholesky.factorize(gfg), IndeterminantLinearSystemException);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
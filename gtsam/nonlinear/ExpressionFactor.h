@@ -114,9 +114,34 @@ protected:
     // Create a writeable JacobianFactor in advance
     boost::shared_ptr<JacobianFactor> factor(
         new JacobianFactor(keys_, dims_, Dim, noiseModel));
+    linearizeInto(x, *factor);
+    return factor;
+  }
+
+  /// Linearize, re-using the JacobianFactor of a previous linearization if it is not shared
+  virtual void linearizeInPlace(const Values& x,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& /*workspace*/) const {
+    JacobianFactor* factor = dynamic_cast<JacobianFactor*>(linearFactor.get());
+    if (!factor || !linearFactor.unique() || !active(x) || factor->keys() != keys_
+        || factor->rows() != Dim) {
+      linearFactor = linearize(x);
+      return;
+    }
+    linearizeInto(x, *factor);
+  }
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
 
+protected:
+  /// Write the whitened Jacobians and error at x into a factor of the right shape
+  void linearizeInto(const Values& x, JacobianFactor& factor) const {
     // Wrap keys and VerticalBlockMatrix into structure passed to expression_
-    VerticalBlockMatrix& Ab = factor->matrixObject();
+    VerticalBlockMatrix& Ab = factor.matrixObject();
     internal::JacobianMap jacobianMap(keys_, Ab);
 
     // Zero out Jacobian so we can simply add to it
@@ -133,17 +158,8 @@ protected:
       Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
       noiseModel_->WhitenSystem(Ab.matrix(), b);
     }
-
-    return factor;
-  }
-
-  /// @return a deep copy of this factor
-  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
-    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
-        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
   }
 
-protected:
  ExpressionFactor() {}
  /// Default constructor, for serialization
 
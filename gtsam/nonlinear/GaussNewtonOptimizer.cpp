@@ -46,7 +46,7 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
 
   // Linearize graph
   gttic(GaussNewtonOptimizer_Linearize);
-  GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  GaussianFactorGraph::shared_ptr linear = linearizeGraph(state_->values);
   gttoc(GaussNewtonOptimizer_Linearize);
 
   // Solve Factor Graph
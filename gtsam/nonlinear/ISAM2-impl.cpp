@@ -58,11 +58,15 @@ size_t DeltaImpl::UpdateGaussNewtonDelta(const ISAM2::Roots& roots,
     lastBacksubVariableCount = delta->size();
 
   } else {
-    // Optimize with wildfire
+    // Optimize with wildfire, in parallel tasks if threads are available
+    const bool parallel = TaskGroup::MaxConcurrency() > 1;
     lastBacksubVariableCount = 0;
     for (const ISAM2::sharedClique& root : roots)
-      lastBacksubVariableCount += optimizeWildfireNonRecursive(
-          root, wildfireThreshold, replacedKeys, delta);  // modifies delta
+      lastBacksubVariableCount +=
+          parallel ? optimizeWildfireParallel(root, wildfireThreshold,
+                                              replacedKeys, delta)
+                   : optimizeWildfireNonRecursive(root, wildfireThreshold,
+                                                  replacedKeys, delta);
 
 #if !defined(NDEBUG) && defined(GTSAM_EXTRA_CONSISTENCY_CHECKS)
     for (VectorValues::const_iterator key_delta = delta->begin();
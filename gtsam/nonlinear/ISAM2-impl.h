@@ -21,6 +21,7 @@
 #include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 
+#include <gtsam/base/TaskGroup.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/inference/JunctionTree-inst.h>  // We need the inst file because we'll make a special JT templated on ISAM2
 #include <gtsam/inference/Symbol.h>
@@ -371,11 +372,63 @@ struct GTSAM_EXPORT UpdateImpl {
     return relinKeys;
   }
 
+  /**
+   * How far the delta of variable \c key is above the relinearization
+   * threshold, used to choose the variables to relinearize first when their
+   * number is limited: the largest ratio of the delta to the threshold over
+   * the dimensions of the variable, or the largest delta for a zero
+   * threshold.
+   */
+  static double RelinearizationPriority(
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold,
+      Key key, const Vector& delta) {
+    if (const double* threshold = boost::get<double>(&relinearizeThreshold)) {
+      const double maxDelta = delta.lpNorm<Eigen::Infinity>();
+      return *threshold > 0.0 ? maxDelta / *threshold : maxDelta;
+    }
+    const Vector& thresholds =
+        boost::get<FastMap<char, Vector> >(relinearizeThreshold)
+            .find(Symbol(key).chr())
+            ->second;
+    return (delta.array().abs() / thresholds.array()).maxCoeff();
+  }
+
+  /**
+   * If there are more than ISAM2UpdateParams::maxRelinearizedVariables keys
+   * in \c relinKeys, move the keys with the smallest priority (see
+   * RelinearizationPriority) to \c deferredKeys.
+   */
+  void limitRelinearizeKeys(const VectorValues& delta, KeySet* relinKeys,
+                            KeySet* deferredKeys) const {
+    const size_t maxKeys = updateParams_.maxRelinearizedVariables;
+    if (maxKeys == 0 || relinKeys->size() <= maxKeys) return;
+    gttic(limitRelinearizeKeys);
+    std::vector<std::pair<double, Key> > priorities;
+    priorities.reserve(relinKeys->size());
+    for (Key key : *relinKeys)
+      priorities.emplace_back(
+          RelinearizationPriority(params_.relinearizeThreshold, key,
+                                  delta[key]),
+          key);
+    // Highest priority first, and smallest key first among equal priorities
+    std::sort(priorities.begin(), priorities.end(),
+              [](const std::pair<double, Key>& a,
+                 const std::pair<double, Key>& b) {
+                return a.first > b.first ||
+                       (a.first == b.first && a.second < b.second);
+              });
+    for (size_t i = maxKeys; i < priorities.size(); ++i) {
+      relinKeys->erase(priorities[i].second);
+      deferredKeys->insert(priorities[i].second);
+    }
+  }
+
   // Mark keys in \Delta above threshold \beta:
   KeySet gatherRelinearizeKeys(const ISAM2::Roots& roots,
                                const VectorValues& delta,
                                const KeySet& fixedVariables,
-                               KeySet* markedKeys) const {
+                               KeySet* markedKeys,
+                               KeySet* deferredKeys) const {
     gttic(gatherRelinearizeKeys);
     // J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
     KeySet relinKeys =
@@ -396,6 +449,9 @@ struct GTSAM_EXPORT UpdateImpl {
       }
     }
 
+    // Defer the relinearization of the variables over budget
+    limitRelinearizeKeys(delta, &relinKeys, deferredKeys);
+
     // Add the variables being relinearized to the marked keys
     markedKeys->insert(relinKeys.begin(), relinKeys.end());
     return relinKeys;
@@ -472,14 +528,18 @@ struct GTSAM_EXPORT UpdateImpl {
                            const FactorIndices& newFactorsIndices,
                            GaussianFactorGraph* linearFactors) const {
     gttic(linearizeNewFactors);
-    auto linearized = newFactors.linearize(theta);
-    if (params_.findUnusedFactorSlots) {
-      linearFactors->resize(numNonlinearFactors);
-      for (size_t i = 0; i < newFactors.size(); ++i)
-        (*linearFactors)[newFactorsIndices[i]] = (*linearized)[i];
-    } else {
-      linearFactors->push_back(*linearized);
-    }
+    // Linearize in parallel, directly into the slots of the new factors
+    const size_t firstNew = linearFactors->size();
+    linearFactors->resize(params_.findUnusedFactorSlots ? numNonlinearFactors
+                                                        : firstNew + newFactors.size());
+    TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+    ParallelFor(0, newFactors.size(), 16, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        const size_t slot = params_.findUnusedFactorSlots ? newFactorsIndices[i] : firstNew + i;
+        (*linearFactors)[slot] =
+            newFactors[i] ? newFactors[i]->linearize(theta) : GaussianFactor::shared_ptr();
+      }
+    });
     assert(linearFactors->size() == numNonlinearFactors);
   }
 
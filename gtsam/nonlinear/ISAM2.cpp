@@ -20,12 +20,15 @@
 #include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 
+#include <gtsam/base/TaskGroup.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/inference/BayesTree-inst.h>
 #include <gtsam/nonlinear/LinearContainerFactor.h>
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <map>
 #include <utility>
 
@@ -37,14 +40,15 @@ namespace gtsam {
 template class BayesTree<ISAM2Clique>;
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : params_(params), update_count_(0), frontEstimateBuffer_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2() : update_count_(0), frontEstimateBuffer_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -72,29 +76,46 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
   affectedKeysSet.insert(affectedKeys.begin(), affectedKeys.end());
   gttoc(affectedKeysSet);
 
-  gttic(check_candidates_and_linearize);
-  GaussianFactorGraph linearized;
+  gttic(check_candidates);
+  // Find the candidates involving only affected keys, and whether their cached linear factors
+  // can be used
+  FastVector<FactorIndex> inside;
+  FastVector<char> useCached;
   for (const FactorIndex idx : candidates) {
-    bool inside = true;
+    bool isInside = true;
     bool useCachedLinear = params_.cacheLinearizedFactors;
     for (Key key : nonlinearFactors_[idx]->keys()) {
       if (affectedKeysSet.find(key) == affectedKeysSet.end()) {
-        inside = false;
+        isInside = false;
         break;
       }
       if (useCachedLinear && relinKeys.find(key) != relinKeys.end())
         useCachedLinear = false;
     }
-    if (inside) {
-      if (useCachedLinear) {
+    if (isInside) {
+      inside.push_back(idx);
+      useCached.push_back(useCachedLinear);
+    }
+  }
+  gttoc(check_candidates);
+
+  gttic(linearize);
+  // Linearize in parallel, each factor into its own slot so that the order does not change
+  GaussianFactorGraph linearized;
+  linearized.resize(inside.size());
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  ParallelFor(0, inside.size(), 16, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      const FactorIndex idx = inside[i];
+      if (useCached[i]) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
         assert(linearFactors_[idx]);
         assert(linearFactors_[idx]->keys() == nonlinearFactors_[idx]->keys());
 #endif
-        linearized.push_back(linearFactors_[idx]);
+        linearized[i] = linearFactors_[idx];
       } else {
         auto linearFactor = nonlinearFactors_[idx]->linearize(theta_);
-        linearized.push_back(linearFactor);
+        linearized[i] = linearFactor;
         if (params_.cacheLinearizedFactors) {
 #ifdef GTSAM_EXTRA_CONSISTENCY_CHECKS
           assert(linearFactors_[idx]->keys() == linearFactor->keys());
@@ -103,19 +124,50 @@ GaussianFactorGraph ISAM2::relinearizeAffectedFactors(
         }
       }
     }
-  }
-  gttoc(check_candidates_and_linearize);
+  });
+  gttoc(linearize);
 
   return linearized;
 }
 
+/* ************************************************************************* */
+namespace {
+// Ordering constraints over the variables of variableIndex that eliminate the
+// leafKeys first, and keep the requested groups, or else the observed keys,
+// last.  Only the variables in variableIndex are visited, so that an
+// incremental update does not touch the rest of the Bayes tree.
+FastMap<Key, int> leafConstraintGroups(const VariableIndex& variableIndex,
+                                       const KeyVector& leafKeys,
+                                       const ISAM2UpdateParams& updateParams,
+                                       const KeyVector& observedKeys) {
+  FastMap<Key, int> constraintGroups;
+  for (const auto& key_factors : variableIndex)
+    constraintGroups.emplace_hint(constraintGroups.end(), key_factors.first, 1);
+  auto setGroup = [&constraintGroups](Key key, int group) {
+    auto iter = constraintGroups.find(key);
+    if (iter != constraintGroups.end()) iter->second = group;
+  };
+  if (updateParams.constrainedKeys) {
+    for (const auto& key_group : *updateParams.constrainedKeys)
+      setGroup(key_group.first, key_group.second + 1);
+  } else {
+    for (Key key : observedKeys) setGroup(key, 2);
+  }
+  for (Key key : leafKeys) setGroup(key, 0);
+  return constraintGroups;
+}
+}  // namespace
+
 /* ************************************************************************* */
 void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
-                        const KeySet& relinKeys, ISAM2Result* result) {
+                        const KeySet& relinKeys, const KeyVector& leafKeys,
+                        ISAM2Result* result,
+                        const boost::optional<Ordering>& batchOrdering) {
   gttic(recalculate);
   UpdateImpl::LogRecalculateKeys(*result);
 
-  if (!result->markedKeys.empty() || !result->observedKeys.empty()) {
+  if (!result->markedKeys.empty() || !result->observedKeys.empty() ||
+      batchOrdering) {
     // Remove top of Bayes tree and convert to a factor graph:
     // (a) For each affected variable, remove the corresponding clique and all
     // parents up to the root. (b) Store orphaned sub-trees \BayesTree_{O} of
@@ -150,11 +202,13 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
     KeySet affectedKeysSet;
     static const double kBatchThreshold = 0.65;
-    if (affectedKeys.size() >= theta_.size() * kBatchThreshold) {
+    if (batchOrdering ||
+        affectedKeys.size() >= theta_.size() * kBatchThreshold) {
       // Do a batch step - reorder and relinearize all variables
-      recalculateBatch(updateParams, &affectedKeysSet, result);
+      recalculateBatch(updateParams, leafKeys, batchOrdering, &affectedKeysSet,
+                       result);
     } else {
-      recalculateIncremental(updateParams, relinKeys, affectedKeys,
+      recalculateIncremental(updateParams, relinKeys, leafKeys, affectedKeys,
                              &affectedKeysSet, &orphans, result);
     }
 
@@ -172,6 +226,8 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
 /* ************************************************************************* */
 void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
+                             const KeyVector& leafKeys,
+                             const boost::optional<Ordering>& batchOrdering,
                              KeySet* affectedKeysSet, ISAM2Result* result) {
   gttic(recalculateBatch);
 
@@ -192,9 +248,29 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
 
   gttic(ordering);
   Ordering order;
-  if (updateParams.constrainedKeys) {
+  if (!leafKeys.empty()) {
+    order = Ordering::ColamdConstrained(
+        affectedFactorsVarIndex,
+        leafConstraintGroups(affectedFactorsVarIndex, leafKeys, updateParams,
+                             result->observedKeys));
+  } else if (updateParams.constrainedKeys) {
     order = Ordering::ColamdConstrained(affectedFactorsVarIndex,
                                         *updateParams.constrainedKeys);
+  } else if (batchOrdering) {
+    // The batch ordering, followed by the variables that were added since it
+    // was computed. As in the Colamd case below, the observed variables are
+    // constrained to be eliminated last.
+    KeySet ordered(result->observedKeys);
+    for (Key key : *batchOrdering) {
+      if (affectedFactorsVarIndex.find(key) != affectedFactorsVarIndex.end() &&
+          ordered.insert(key).second)
+        order.push_back(key);
+    }
+    for (const auto& key_factors : affectedFactorsVarIndex)
+      if (!ordered.exists(key_factors.first)) order.push_back(key_factors.first);
+    for (Key key : result->observedKeys)
+      if (affectedFactorsVarIndex.find(key) != affectedFactorsVarIndex.end())
+        order.push_back(key);
   } else {
     if (theta_.size() > result->observedKeys.size()) {
       // Only if some variables are unconstrained
@@ -243,6 +319,7 @@ void ISAM2::recalculateBatch(const ISAM2UpdateParams& updateParams,
 /* ************************************************************************* */
 void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
                                    const KeySet& relinKeys,
+                                   const KeyVector& leafKeys,
                                    const FastList<Key>& affectedKeys,
                                    KeySet* affectedKeysSet, Cliques* orphans,
                                    ISAM2Result* result) {
@@ -312,7 +389,10 @@ void ISAM2::recalculateIncremental(const ISAM2UpdateParams& updateParams,
   gttic(ordering_constraints);
   // Create ordering constraints
   FastMap<Key, int> constraintGroups;
-  if (updateParams.constrainedKeys) {
+  if (!leafKeys.empty()) {
+    constraintGroups = leafConstraintGroups(affectedFactorsVarIndex, leafKeys,
+                                            updateParams, result->observedKeys);
+  } else if (updateParams.constrainedKeys) {
     constraintGroups = *updateParams.constrainedKeys;
   } else {
     constraintGroups = FastMap<Key, int>();
@@ -362,6 +442,8 @@ void ISAM2::addVariables(const Values& newTheta,
   gttic(addNewVariables);
 
   theta_.insert(newTheta);
+  if (params_.marginalizationLag > 0 && !newTheta.empty())
+    addedVariables_.emplace_back(update_count_, newTheta.keys());
   if (ISDEBUG("ISAM2 AddVariables")) newTheta.print("The new variables are: ");
   // Add zeros into the VectorValues
   delta_.insert(newTheta.zeroVectors());
@@ -389,7 +471,9 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
     fixedVariables_.erase(key);
+    deferredRelinKeys_.erase(key);
   }
+  markEstimatesStale(unusedKeys);
 }
 
 /* ************************************************************************* */
@@ -413,15 +497,34 @@ ISAM2Result ISAM2::update(
 /* ************************************************************************* */
 ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
                           const Values& newTheta,
-                          const ISAM2UpdateParams& updateParams) {
+                          const ISAM2UpdateParams& requestedParams) {
   gttic(ISAM2_update);
+  // Check the background ordering before changing any state, so that if
+  // computing it failed, the exception leaves this ISAM2 unchanged
+  const bool batchOrderingReady = reorderingJob_ && batchReorderingReady();
+
   this->update_count_ += 1;
   UpdateImpl::LogStartingUpdate(newFactors, *this);
   ISAM2Result result(params_.enableDetailedResults);
+
+  // Variables that left the marginalization window are reordered to the leaves
+  // and marginalized at the end of this update
+  const KeyVector expiredKeys = findExpiredVariables();
+  boost::optional<ISAM2UpdateParams> leafParams;
+  if (!expiredKeys.empty())
+    leafParams = constrainToLeaves(requestedParams, expiredKeys);
+  const ISAM2UpdateParams& updateParams =
+      leafParams ? *leafParams : requestedParams;
   UpdateImpl update(params_, updateParams);
 
+  // Check relinearization if it is due, or to catch up with deferred
+  // relinearizations
+  const bool relinearizationNeeded =
+      update.relinarizationNeeded(update_count_) ||
+      (params_.enableRelinearization && !deferredRelinKeys_.empty());
+
   // Update delta if we need it to check relinearization later
-  if (update.relinarizationNeeded(update_count_))
+  if (relinearizationNeeded && !relinearizationJob_)
     updateDelta(updateParams.forceFullSolve);
 
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
@@ -444,10 +547,39 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
 
   KeySet relinKeys;
   result.variablesRelinearized = 0;
-  if (update.relinarizationNeeded(update_count_)) {
+  result.variablesAboveRelinThreshold = 0;
+  result.batchReordered = false;
+  if (relinearizationJob_) {
+    // 4-6. Swap in the background relinearization if it is done.  Its factors
+    // are already relinearized, so relinKeys stays empty.
+    const KeySet relinearized =
+        finishRelinearization(updateParams.force_relinearize);
+    if (!relinearized.empty()) {
+      result.markedKeys.insert(relinearized.begin(), relinearized.end());
+      update.recordRelinearizeDetail(relinearized, result.details());
+      update.findFluid(roots_, relinearized, &result.markedKeys,
+                       result.details());
+      markEstimatesStale(relinearized);
+    }
+    result.variablesRelinearized = result.markedKeys.size();
+  } else if (relinearizationNeeded && params_.backgroundRelinearization) {
+    // 4. Start relinearizing the keys in \Delta above threshold \beta
+    KeySet backgroundMarkedKeys;
+    const KeySet backgroundKeys = update.gatherRelinearizeKeys(
+        roots_, delta_, fixedVariables_, &backgroundMarkedKeys,
+        &result.deferredRelinKeys);
+    result.variablesAboveRelinThreshold =
+        backgroundKeys.size() + result.deferredRelinKeys.size();
+    startRelinearization(backgroundKeys);
+    deferredRelinKeys_ = result.deferredRelinKeys;
+  } else if (relinearizationNeeded) {
     // 4. Mark keys in \Delta above threshold \beta:
     relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
-                                             &result.markedKeys);
+                                             &result.markedKeys,
+                                             &result.deferredRelinKeys);
+    result.variablesAboveRelinThreshold =
+        relinKeys.size() + result.deferredRelinKeys.size();
+    deferredRelinKeys_ = result.deferredRelinKeys;
     update.recordRelinearizeDetail(relinKeys, result.details());
     if (!relinKeys.empty()) {
       // 5. Mark cliques that involve marked variables \Theta_{J} and ancestors.
@@ -455,6 +587,7 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       // 6. Update linearization point for marked variables:
       // \Theta_{J}:=\Theta_{J}+\Delta_{J}.
       UpdateImpl::ExpmapMasked(delta_, relinKeys, &theta_);
+      markEstimatesStale(relinKeys);
     }
     result.variablesRelinearized = result.markedKeys.size();
   }
@@ -465,18 +598,48 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   update.augmentVariableIndex(newFactors, result.newFactorsIndices,
                               &variableIndex_);
 
-  // 8. Redo top of Bayes tree and update data structures
-  recalculate(updateParams, relinKeys, &result);
+  // 8. Redo top of Bayes tree and update data structures, or the whole tree if
+  // a batch ordering is ready
+  boost::optional<Ordering> batchOrdering;
+  if (batchOrderingReady && !updateParams.constrainedKeys &&
+      expiredKeys.empty())
+    batchOrdering = finishBatchReordering();
+  result.batchReordered = static_cast<bool>(batchOrdering);
+  recalculate(updateParams, relinKeys, expiredKeys, &result, batchOrdering);
   if (!result.unusedKeys.empty()) removeVariables(result.unusedKeys);
+  if (!expiredKeys.empty()) {
+    // Variables removed as unused are no longer there to marginalize
+    for (Key key : expiredKeys)
+      if (theta_.exists(key)) result.marginalizedKeys.push_back(key);
+    marginalizeLeavesImpl(
+        FastList<Key>(result.marginalizedKeys.begin(),
+                      result.marginalizedKeys.end()),
+        boost::none, boost::none);
+  }
   result.cliques = this->nodes().size();
+  if (params_.evaluateFillStatistics) result.fill = fillStatistics();
+  if (params_.batchReorderInterval > 0 && !reorderingJob_ &&
+      update_count_ % params_.batchReorderInterval == 0)
+    startBatchReordering();
 
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
+  if (params_.publishEstimates) publishEstimate();
   return result;
 }
 
 /* ************************************************************************* */
 void ISAM2::marginalizeLeaves(
+    const FastList<Key>& leafKeys,
+    boost::optional<FactorIndices&> marginalFactorsIndices,
+    boost::optional<FactorIndices&> deletedFactorsIndices) {
+  marginalizeLeavesImpl(leafKeys, marginalFactorsIndices,
+                        deletedFactorsIndices);
+  if (params_.publishEstimates) publishEstimate();
+}
+
+/* ************************************************************************* */
+void ISAM2::marginalizeLeavesImpl(
     const FastList<Key>& leafKeysList,
     boost::optional<FactorIndices&> marginalFactorsIndices,
     boost::optional<FactorIndices&> deletedFactorsIndices) {
@@ -658,24 +821,35 @@ void ISAM2::marginalizeLeaves(
   // At this point we have updated the BayesTree, now update the remaining iSAM2
   // data structures
 
-  // Gather factors to add - the new marginal factors
+  // Gather factors to add - the new marginal factors.  They are added before
+  // the summarized factors are removed, so if findUnusedFactorSlots is set,
+  // they only reuse slots emptied before this call, and their indices are never
+  // among the indices of the removed factors.
   GaussianFactorGraph factorsToAdd;
+  NonlinearFactorGraph marginalContainers;
   for (const auto& key_factors : marginalFactors) {
     for (const auto& factor : key_factors.second) {
       if (factor) {
         factorsToAdd.push_back(factor);
-        if (marginalFactorsIndices)
-          marginalFactorsIndices->push_back(nonlinearFactors_.size());
-        nonlinearFactors_.push_back(
+        marginalContainers.push_back(
             boost::make_shared<LinearContainerFactor>(factor));
-        if (params_.cacheLinearizedFactors) linearFactors_.push_back(factor);
         for (Key factorKey : *factor) {
           fixedVariables_.insert(factorKey);
         }
       }
     }
   }
-  variableIndex_.augment(factorsToAdd);  // Augment the variable index
+  const FactorIndices newIndices = nonlinearFactors_.add_factors(
+      marginalContainers, params_.findUnusedFactorSlots);
+  if (params_.cacheLinearizedFactors) {
+    linearFactors_.resize(nonlinearFactors_.size());
+    for (size_t i = 0; i < newIndices.size(); ++i)
+      linearFactors_[newIndices[i]] = factorsToAdd[i];
+  }
+  if (marginalFactorsIndices)
+    marginalFactorsIndices->insert(marginalFactorsIndices->end(),
+                                   newIndices.begin(), newIndices.end());
+  variableIndex_.augment(factorsToAdd, newIndices);  // Augment the variable index
 
   // Remove the factors to remove that have been summarized in the newly-added
   // marginal factors
@@ -780,6 +954,327 @@ Values ISAM2::calculateBestEstimate() const {
   return theta_.retract(delta_);
 }
 
+/* ************************************************************************* */
+void ISAM2::publishEstimate() {
+  gttic(publishEstimate);
+  const VectorValues& delta = getDelta();
+  EstimateBuffer& front = estimateBuffers_[frontEstimateBuffer_];
+  EstimateBuffer& back = estimateBuffers_[1 - frontEstimateBuffer_];
+
+  // The back buffer may only be modified once readers have released it
+  if (back.values && !back.values.unique()) back.values.reset();
+  if (!back.values) {
+    if (front.values) {
+      back.values = boost::make_shared<Values>(*front.values);
+      back.delta = front.delta;
+      back.staleKeys = front.staleKeys;
+    } else {
+      back.values = boost::make_shared<Values>(theta_.retract(delta));
+      back.delta = delta;
+      back.staleKeys.clear();
+    }
+  }
+
+  // Drop the variables that were removed or relinearized, the latter are
+  // retracted again below
+  for (Key key : back.staleKeys) {
+    if (back.values->exists(key)) {
+      back.values->erase(key);
+      back.delta.erase(key);
+    }
+  }
+  back.staleKeys.clear();
+
+  // Retract the variables that are new, or whose delta changed
+  for (const auto& key_delta : delta) {
+    const Key key = key_delta.first;
+    const Vector& d = key_delta.second;
+    const auto it = back.delta.find(key);
+    if (it == back.delta.end() || it->second != d) {
+      const Value* retracted = theta_.at(key).retract_(d);
+      if (it == back.delta.end()) {
+        back.values->insert(key, *retracted);
+        back.delta.insert(key, d);
+      } else {
+        back.values->update(key, *retracted);
+        it->second = d;
+      }
+      retracted->deallocate_();
+    }
+  }
+
+  estimateSnapshot_.store(back.values);
+  frontEstimateBuffer_ = 1 - frontEstimateBuffer_;
+}
+
+/* ************************************************************************* */
+void ISAM2::markEstimatesStale(const KeySet& keys) {
+  if (!params_.publishEstimates) return;
+  for (EstimateBuffer& buffer : estimateBuffers_)
+    if (buffer.values) buffer.staleKeys.insert(keys.begin(), keys.end());
+}
+
+/* ************************************************************************* */
+struct ISAM2::RelinearizationJob {
+  KeySet relinKeys;  ///< The variables being relinearized
+  Values theta;      ///< Their new linearization points
+  FactorIndices factorIndices;  ///< The indices of the factors involving them
+  NonlinearFactorGraph factors;  ///< These factors, when the job was started
+  /// The factors linearized at the new linearization point, in the same order
+  GaussianFactorGraph linearized;
+  std::exception_ptr exception;  ///< Thrown while linearizing in the background
+  std::atomic<bool> done;  ///< Whether linearized is complete or exception is set
+  mutable TaskGroup group;  ///< Runs the linearization, if in the background
+  RelinearizationJob() : done(false) {}
+};
+
+/* ************************************************************************* */
+void ISAM2::startRelinearization(const KeySet& relinKeys) {
+  if (relinKeys.empty()) return;
+  gttic(startRelinearization);
+  auto job = boost::make_shared<RelinearizationJob>();
+  job->relinKeys = relinKeys;
+
+  // The factors involving the relinearized variables
+  FactorIndexSet indices;
+  for (Key key : relinKeys) {
+    const auto& involved = variableIndex_[key];
+    indices.insert(involved.begin(), involved.end());
+  }
+  Values theta;
+  for (const FactorIndex idx : indices) {
+    const auto& factor = nonlinearFactors_[idx];
+    if (!factor) continue;
+    job->factorIndices.push_back(idx);
+    job->factors.push_back(factor);
+    for (Key key : factor->keys())
+      if (!theta.exists(key)) theta.insert(key, theta_.at(key));
+  }
+
+  // The snapshot of the linearization point of their variables, with the
+  // relinearized variables updated: \Theta_{J}:=\Theta_{J}+\Delta_{J}
+  for (Key key : relinKeys) {
+    Value* retracted = theta_.at(key).retract_(delta_[key]);
+    if (theta.exists(key))
+      theta.update(key, *retracted);
+    else
+      theta.insert(key, *retracted);
+    job->theta.insert(key, *retracted);
+    retracted->deallocate_();
+  }
+
+  // The factors are linearized in the background from clones, as the
+  // foreground keeps evaluating and linearizing the originals, which may have
+  // mutable caches.  Without clones, or a thread to run on, they are
+  // linearized here, and only swapped in by the next update.
+  NonlinearFactorGraph clones;
+  if (TaskGroup::MaxConcurrency() > 1) {
+    clones.reserve(job->factors.size());
+    try {
+      for (const auto& factor : job->factors) clones.push_back(factor->clone());
+    } catch (const std::runtime_error&) {
+      clones.resize(0);  // A factor does not implement clone()
+    }
+  }
+  if (clones.size() == job->factors.size() && !clones.empty()) {
+    // The job outlives the task, since destroying it waits for its group
+    RelinearizationJob* background = job.get();
+    auto factors = boost::make_shared<const NonlinearFactorGraph>(
+        std::move(clones));
+    auto point = boost::make_shared<const Values>(std::move(theta));
+    job->group.run([background, factors, point]() {
+      // No timing here, the timing tree is not thread-safe
+      try {
+        background->linearized.reserve(factors->size());
+        for (const auto& factor : *factors)
+          background->linearized.push_back(factor->linearize(*point));
+      } catch (...) {
+        background->exception = std::current_exception();
+      }
+      background->done = true;
+    });
+  } else {
+    job->linearized.reserve(job->factors.size());
+    for (const auto& factor : job->factors)
+      job->linearized.push_back(factor->linearize(theta));
+    job->done = true;
+  }
+  relinearizationJob_ = job;
+}
+
+/* ************************************************************************* */
+KeySet ISAM2::finishRelinearization(bool wait) {
+  const auto job = relinearizationJob_;
+  if (!wait && !job->done) return KeySet();
+  gttic(finishRelinearization);
+  relinearizationJob_.reset();
+  job->group.wait();
+  // The failed job is dropped, so the next relinearization starts a new one
+  if (job->exception) std::rethrow_exception(job->exception);
+  const GaussianFactorGraph& linearized = job->linearized;
+
+  // Update the linearization point of the variables that were not removed or
+  // fixed (by marginalizeLeaves()) in the meantime
+  KeySet relinKeys;
+  for (Key key : job->relinKeys) {
+    if (theta_.exists(key) && !fixedVariables_.exists(key)) {
+      theta_.update(key, job->theta.at(key));
+      relinKeys.insert(key);
+    }
+  }
+
+  // Cache the relinearized factors that are still there, unless they involve
+  // variables that were not updated
+  FactorIndexSet relinearized;
+  for (size_t i = 0; i < job->factorIndices.size(); ++i) {
+    const FactorIndex idx = job->factorIndices[i];
+    if (idx >= nonlinearFactors_.size() ||
+        nonlinearFactors_[idx] != job->factors[i])
+      continue;
+    const auto& keys = job->factors[i]->keys();
+    if (std::any_of(keys.begin(), keys.end(), [&](Key key) {
+          return job->relinKeys.exists(key) && !relinKeys.exists(key);
+        }))
+      continue;
+    if (params_.cacheLinearizedFactors) linearFactors_[idx] = linearized[i];
+    relinearized.insert(idx);
+  }
+
+  // Relinearize the other factors involving the updated variables
+  if (params_.cacheLinearizedFactors) {
+    for (Key key : relinKeys) {
+      for (const FactorIndex idx : variableIndex_[key]) {
+        if (nonlinearFactors_[idx] && relinearized.insert(idx).second)
+          linearFactors_[idx] = nonlinearFactors_[idx]->linearize(theta_);
+      }
+    }
+  }
+  return relinKeys;
+}
+
+/* ************************************************************************* */
+KeyVector ISAM2::findExpiredVariables() {
+  KeyVector expiredKeys;
+  while (!addedVariables_.empty() &&
+         addedVariables_.front().first <=
+             update_count_ - params_.marginalizationLag) {
+    for (Key key : addedVariables_.front().second)
+      if (theta_.exists(key)) expiredKeys.push_back(key);
+    addedVariables_.pop_front();
+  }
+  return expiredKeys;
+}
+
+namespace {
+// Add the frontal keys of the cliques below \c clique that have \c key in their
+// separator, which have to be re-eliminated for \c key to become a leaf
+void markSeparatorDescendants(Key key, const ISAM2::sharedClique& clique,
+                              KeySet* keys) {
+  for (const auto& child : clique->children) {
+    const auto& conditional = child->conditional();
+    if (std::find(conditional->beginParents(), conditional->endParents(),
+                  key) != conditional->endParents()) {
+      keys->insert(conditional->beginFrontals(), conditional->endFrontals());
+      markSeparatorDescendants(key, child, keys);
+    }
+  }
+}
+}  // namespace
+
+/* ************************************************************************* */
+ISAM2UpdateParams ISAM2::constrainToLeaves(
+    const ISAM2UpdateParams& updateParams, const KeyVector& leafKeys) const {
+  gttic(constrainToLeaves);
+  ISAM2UpdateParams leafParams = updateParams;
+
+  // Re-eliminate the leaf keys, and the cliques below them that have them in
+  // their separator
+  KeySet reelimKeys(leafKeys.begin(), leafKeys.end());
+  for (Key key : leafKeys) markSeparatorDescendants(key, nodes_.at(key),
+                                                    &reelimKeys);
+  if (updateParams.extraReelimKeys)
+    reelimKeys.insert(updateParams.extraReelimKeys->begin(),
+                      updateParams.extraReelimKeys->end());
+  leafParams.extraReelimKeys =
+      FastList<Key>(reelimKeys.begin(), reelimKeys.end());
+  return leafParams;
+}
+
+/* ************************************************************************* */
+struct ISAM2::ReorderingJob {
+  /// The ordering of the variables of the factors, when the job was started
+  Ordering ordering;
+  std::exception_ptr exception;  ///< Thrown while computing the ordering
+  std::atomic<bool> done;  ///< Whether ordering or exception is set
+  mutable TaskGroup group;  ///< Computes the ordering, if in the background
+  ReorderingJob() : done(false) {}
+};
+
+/* ************************************************************************* */
+void ISAM2::startBatchReordering() {
+  if (nonlinearFactors_.empty()) return;
+  gttic(startBatchReordering);
+  auto job = boost::make_shared<ReorderingJob>();
+  // The factors are shared with the snapshot, but their keys never change
+  ReorderingJob* background = job.get();
+  const NonlinearFactorGraph factors = nonlinearFactors_;
+  const Ordering::OrderingType orderingType = params_.batchReorderingType;
+  auto computeOrdering = [background, factors, orderingType]() {
+    try {
+      background->ordering = Ordering::Create(orderingType, factors);
+    } catch (...) {
+      background->exception = std::current_exception();
+    }
+    background->done = true;
+  };
+  // Without a thread to run on, the task would only run when waited for
+  if (TaskGroup::MaxConcurrency() > 1)
+    job->group.run(computeOrdering);
+  else
+    computeOrdering();
+  reorderingJob_ = job;
+}
+
+/* ************************************************************************* */
+bool ISAM2::batchReorderingReady() {
+  if (!reorderingJob_->done) return false;
+  reorderingJob_->group.wait();
+  if (reorderingJob_->exception) {
+    const std::exception_ptr exception = reorderingJob_->exception;
+    reorderingJob_.reset();
+    std::rethrow_exception(exception);
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+Ordering ISAM2::finishBatchReordering() {
+  const Ordering ordering = reorderingJob_->ordering;
+  reorderingJob_.reset();
+  return ordering;
+}
+
+/* ************************************************************************* */
+ISAM2Result::FillStatistics ISAM2::fillStatistics() const {
+  gttic(fillStatistics);
+  ISAM2Result::FillStatistics fill = {0, 0, 0.0};
+  size_t cliques = 0, cliqueSizes = 0;
+  std::vector<sharedClique> stack(roots_.begin(), roots_.end());
+  while (!stack.empty()) {
+    const sharedClique clique = stack.back();
+    stack.pop_back();
+    const auto& conditional = clique->conditional();
+    const size_t dimR = conditional->rows();
+    fill.nnz += ((dimR + 1) * dimR) / 2 + conditional->S().cols() * dimR;
+    fill.maxCliqueSize = std::max(fill.maxCliqueSize, conditional->size());
+    cliqueSizes += conditional->size();
+    ++cliques;
+    stack.insert(stack.end(), clique->children.begin(), clique->children.end());
+  }
+  if (cliques > 0) fill.meanCliqueSize = double(cliqueSizes) / cliques;
+  return fill;
+}
+
 /* ************************************************************************* */
 Matrix ISAM2::marginalCovariance(Key key) const {
   return marginalFactor(key, params_.getEliminationFunction())
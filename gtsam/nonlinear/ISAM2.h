@@ -27,6 +27,10 @@
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace gtsam {
@@ -96,6 +100,71 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Variables whose relinearization was deferred by the last update, see
+   * ISAM2UpdateParams::maxRelinearizedVariables */
+  KeySet deferredRelinKeys_;
+
+  /** The variables added by each update that are still in the
+   * marginalization window, oldest first, see
+   * ISAM2Params::marginalizationLag */
+  std::deque<std::pair<int, KeyVector> > addedVariables_;
+
+  /** A buffer in which estimates are computed before being published, see
+   * publishEstimate() */
+  struct EstimateBuffer {
+    boost::shared_ptr<Values> values;  ///< The estimate, possibly published
+    VectorValues delta;  ///< The delta from which values was computed
+    KeySet staleKeys;    ///< Keys whose linearization point has changed, or
+                         ///< that were removed, since values was computed
+  };
+
+  /** Two estimate buffers, the front one holding the published estimate while
+   * the other one is brought up to date */
+  EstimateBuffer estimateBuffers_[2];
+  size_t frontEstimateBuffer_;  ///< Index of the front estimate buffer
+
+  /** The published estimate.  The pointer is guarded by a std::mutex, which
+   * is only held to copy or swap it; a copy of the ISAM2 gets a mutex of its
+   * own. */
+  class EstimateSnapshot {
+    mutable std::mutex mutex_;
+    boost::shared_ptr<const Values> values_;
+
+   public:
+    EstimateSnapshot() {}
+    EstimateSnapshot(const EstimateSnapshot& other) : values_(other.load()) {}
+    EstimateSnapshot& operator=(const EstimateSnapshot& other) {
+      store(other.load());
+      return *this;
+    }
+    boost::shared_ptr<const Values> load() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return values_;
+    }
+    /// The previous estimate is released after the mutex
+    void store(boost::shared_ptr<const Values> values) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        values_.swap(values);
+      }
+    }
+  };
+  EstimateSnapshot estimateSnapshot_;
+
+  /** A relinearization running in the background, see
+   * ISAM2Params::backgroundRelinearization */
+  struct RelinearizationJob;
+
+  /** The background relinearization that has not been swapped in yet, if any */
+  boost::shared_ptr<const RelinearizationJob> relinearizationJob_;
+
+  /** An ordering of all variables computed in the background, see
+   * ISAM2Params::batchReorderInterval */
+  struct ReorderingJob;
+
+  /** The background ordering that has not been used yet, if any */
+  boost::shared_ptr<const ReorderingJob> reorderingJob_;
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -194,7 +263,10 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    *
    * If provided, 'deletedFactorsIndices' will be augmented with the factor
    * graph indices of any factor that was removed during the 'marginalizeLeaves'
-   * call
+   * call.  The two sets of indices are disjoint: the marginal factors are
+   * added before the summarized factors are removed, so with
+   * ISAM2Params::findUnusedFactorSlots they only reuse slots emptied before
+   * the call, and the slots of the removed factors are reused later.
    */
   void marginalizeLeaves(
       const FastList<Key>& leafKeys,
@@ -236,9 +308,55 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    */
   const Value& calculateEstimate(Key key) const;
 
+  /** The estimate published at the end of the last update() or
+   * marginalizeLeaves() if ISAM2Params::publishEstimates is set, or null
+   * otherwise.  Each of these publishes once, also when update() marginalizes
+   * variables.  Snapshots are never modified, and this may be called from any
+   * thread, also while update() runs in another one: the published pointer is
+   * copied under a std::mutex, which update() only holds to swap it.  The
+   * snapshot is the same as calculateEstimate() right after the update that
+   * published it.
+   */
+  boost::shared_ptr<const Values> estimateSnapshot() const {
+    return estimateSnapshot_.load();
+  }
+
+  /** Whether a background relinearization was started and has not been
+   * swapped in yet, see ISAM2Params::backgroundRelinearization */
+  bool relinearizationPending() const {
+    return static_cast<bool>(relinearizationJob_);
+  }
+
   /** Return marginal on any variable as a covariance matrix */
   Matrix marginalCovariance(Key key) const;
 
+  /**
+   * Write a checkpoint of the current state to the binary stream \c os, from
+   * which loadCheckpoint() resumes without re-eliminating.  The Bayes tree,
+   * with the conditionals and cached factors of its cliques, the deltas and
+   * the cached linear factors are written as raw blocks of keys and matrix
+   * entries, in the byte order of this machine, which is recorded so that
+   * loading on a machine with another byte order fails.  The linearization
+   * point and the nonlinear factors are written with a boost binary archive,
+   * so their types must be exported as for serialization (see
+   * gtsam/base/serialization.h).  The parameters are not written, and a
+   * background relinearization that is still pending is dropped: its
+   * variables are relinearized again after loading.  So is a pending batch
+   * reordering.
+   */
+  void saveCheckpoint(std::ostream& os) const;
+
+  /**
+   * Replace the current state by the checkpoint written by saveCheckpoint()
+   * to the binary stream \c is.  The variable index is rebuilt from the
+   * nonlinear factors, and the parameters of this instance are kept.  Throws
+   * std::invalid_argument, and leaves this instance unchanged, if \c is does
+   * not hold a valid checkpoint.  If \c is is seekable, sizes are checked
+   * against the bytes left before anything is allocated, so a corrupt
+   * checkpoint does not cause a huge allocation.
+   */
+  void loadCheckpoint(std::istream& is);
+
   /// @name Public members for non-typical usage
   /// @{
 
@@ -282,11 +400,18 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
 
  protected:
   /// Remove marked top and either recalculate in batch or incrementally.
+  /// Always recalculates in batch if a \c batchOrdering is given.  The
+  /// \c leafKeys, if any, are eliminated first so that they become leaves.
   void recalculate(const ISAM2UpdateParams& updateParams,
-                   const KeySet& relinKeys, ISAM2Result* result);
+                   const KeySet& relinKeys, const KeyVector& leafKeys,
+                   ISAM2Result* result,
+                   const boost::optional<Ordering>& batchOrdering = boost::none);
 
-  // Do a batch step - reorder and relinearize all variables
+  // Do a batch step - reorder and relinearize all variables, in the order of
+  // batchOrdering if it is given, with the observed variables last
   void recalculateBatch(const ISAM2UpdateParams& updateParams,
+                        const KeyVector& leafKeys,
+                        const boost::optional<Ordering>& batchOrdering,
                         KeySet* affectedKeysSet, ISAM2Result* result);
 
   // retrieve all factors that ONLY contain the affected variables
@@ -297,6 +422,7 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
 
   void recalculateIncremental(const ISAM2UpdateParams& updateParams,
                               const KeySet& relinKeys,
+                              const KeyVector& leafKeys,
                               const FastList<Key>& affectedKeys,
                               KeySet* affectedKeysSet, Cliques* orphans,
                               ISAM2Result* result);
@@ -315,6 +441,72 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void removeVariables(const KeySet& unusedKeys);
 
   void updateDelta(bool forceFullSolve = false) const;
+
+  /**
+   * Publish the current estimate as the estimateSnapshot().  The estimate is
+   * computed in the back buffer if no reader holds it anymore, re-retracting
+   * only the variables whose delta or linearization point changed since it
+   * was published, or in a copy of the front buffer otherwise.
+   */
+  void publishEstimate();
+
+  /// marginalizeLeaves() without publishing the estimate, which update()
+  /// publishes once at its end
+  void marginalizeLeavesImpl(
+      const FastList<Key>& leafKeys,
+      boost::optional<FactorIndices&> marginalFactorsIndices,
+      boost::optional<FactorIndices&> deletedFactorsIndices);
+
+  /// Mark \c keys as stale in both estimate buffers, if estimates are published
+  void markEstimatesStale(const KeySet& keys);
+
+  /**
+   * Start relinearizing \c relinKeys in the background: their new
+   * linearization points, and the factors involving them at these points,
+   * are computed in a TaskGroup from clones of the factors and copies of the
+   * current linearization point and delta.  If a factor cannot be cloned, or
+   * there is a single thread, the factors are linearized here instead.
+   */
+  void startRelinearization(const KeySet& relinKeys);
+
+  /**
+   * Swap in the background relinearization if it is done, or after waiting
+   * for it if \c wait is set: update the linearization point of the
+   * relinearized variables, and store the relinearized factors in the cached
+   * linear factors.  Factors that involve the relinearized variables but were
+   * added since the relinearization was started are linearized here.
+   * Rethrows, and drops the relinearization, if linearizing a factor threw.
+   * @return The relinearized variables, or an empty set if the relinearization
+   * is not done yet
+   */
+  KeySet finishRelinearization(bool wait);
+
+  /// Remove the variables that left the marginalization window from the
+  /// window, and return those that were not removed otherwise
+  KeyVector findExpiredVariables();
+
+  /**
+   * Return \c updateParams with the extra re-eliminated keys that, together
+   * with the ordering constraints of recalculate(), make \c leafKeys leaves
+   * of the Bayes tree, so they can be marginalized with marginalizeLeaves()
+   * after the update.
+   */
+  ISAM2UpdateParams constrainToLeaves(const ISAM2UpdateParams& updateParams,
+                                      const KeyVector& leafKeys) const;
+
+  /// Start computing an ordering of all variables in the background, from a
+  /// snapshot of the nonlinear factors
+  void startBatchReordering();
+
+  /// Whether the ordering computed in the background is ready.  If computing
+  /// it failed, the background job is dropped and its exception rethrown.
+  bool batchReorderingReady();
+
+  /// Take the ordering computed in the background, once it is ready
+  Ordering finishBatchReordering();
+
+  /// Compute the fill statistics of the Bayes tree
+  ISAM2Result::FillStatistics fillStatistics() const;
 };  // ISAM2
 
 /// traits
@@ -0,0 +1,479 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Checkpoint.cpp
+ * @brief   Binary checkpoints of ISAM2, resumed without re-elimination
+ * @date    Oct 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <gtsam/base/serialization.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <boost/archive/archive_exception.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+const char checkpointMagic[8] = {'G', 'T', 'S', 'A', 'M', 'I', 'S', '2'};
+const uint32_t checkpointVersion = 1;
+// Written in the byte order of the machine, which must match when loading
+const uint32_t byteOrderMarker = 0x01020304;
+
+// Tags of the factors and noise models in a checkpoint
+enum FactorTag : uint8_t {
+  NULL_FACTOR = 0,
+  JACOBIAN_FACTOR = 1,
+  HESSIAN_FACTOR = 2
+};
+enum ModelTag : uint8_t {
+  NO_MODEL = 0,
+  DIAGONAL_MODEL = 1,
+  CONSTRAINED_MODEL = 2
+};
+
+/* ************************************************************************* */
+// A checkpoint being read, with the end of the stream to check the sizes read
+// against, so that a corrupt size is rejected before anything is allocated
+struct Input {
+  istream& is;
+  istream::pos_type end;  ///< -1 if the stream is not seekable
+
+  explicit Input(istream& stream) : is(stream), end(-1) {
+    const istream::pos_type start = is.tellg();
+    if (start == istream::pos_type(-1)) return;
+    is.seekg(0, ios::end);
+    end = is.tellg();
+    is.seekg(start);
+    if (!is) throw invalid_argument("ISAM2::loadCheckpoint: unreadable stream");
+  }
+
+  /// The number of bytes left, or the maximum if it is not known
+  uint64_t bytesLeft() {
+    const istream::pos_type pos = is.tellg();
+    if (end == istream::pos_type(-1) || pos == istream::pos_type(-1))
+      return numeric_limits<uint64_t>::max();
+    return pos < end ? static_cast<uint64_t>(end - pos) : 0;
+  }
+};
+
+/* ************************************************************************* */
+// Raw little helpers, all sizes are written as uint64_t
+template <typename T>
+void write(ostream& os, const T& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeDoubles(ostream& os, const double* data, size_t n) {
+  os.write(reinterpret_cast<const char*>(data), n * sizeof(double));
+}
+
+template <typename T>
+T read(Input& in) {
+  T value;
+  in.is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  if (!in.is)
+    throw invalid_argument("ISAM2::loadCheckpoint: truncated checkpoint");
+  return value;
+}
+
+// Read the number of elements of a container, each taking at least
+// elementSize bytes in the rest of the checkpoint
+size_t readSize(Input& in, size_t elementSize) {
+  const uint64_t n = read<uint64_t>(in);
+  if (n > in.bytesLeft() / elementSize)
+    throw invalid_argument("ISAM2::loadCheckpoint: corrupt size");
+  return static_cast<size_t>(n);
+}
+
+void readDoubles(Input& in, double* data, size_t n) {
+  in.is.read(reinterpret_cast<char*>(data), n * sizeof(double));
+  if (!in.is)
+    throw invalid_argument("ISAM2::loadCheckpoint: truncated checkpoint");
+}
+
+/* ************************************************************************* */
+void writeVector(ostream& os, const Vector& v) {
+  write<uint64_t>(os, v.size());
+  writeDoubles(os, v.data(), v.size());
+}
+
+Vector readVector(Input& in) {
+  Vector v(readSize(in, sizeof(double)));
+  readDoubles(in, v.data(), v.size());
+  return v;
+}
+
+template <class KEYS>
+void writeKeys(ostream& os, const KEYS& keys) {
+  write<uint64_t>(os, keys.size());
+  for (Key key : keys) write<uint64_t>(os, key);
+}
+
+KeyVector readKeys(Input& in) {
+  KeyVector keys(readSize(in, sizeof(uint64_t)));
+  for (Key& key : keys) key = read<uint64_t>(in);
+  return keys;
+}
+
+KeySet readKeySet(Input& in) {
+  const KeyVector keys = readKeys(in);
+  return KeySet(keys.begin(), keys.end());
+}
+
+void writeVectorValues(ostream& os, const VectorValues& values) {
+  write<uint64_t>(os, values.size());
+  for (const auto& key_value : values) {
+    write<uint64_t>(os, key_value.first);
+    writeVector(os, key_value.second);
+  }
+}
+
+VectorValues readVectorValues(Input& in) {
+  VectorValues values;
+  const size_t n = readSize(in, 2 * sizeof(uint64_t));
+  for (size_t i = 0; i < n; ++i) {
+    const Key key = read<uint64_t>(in);
+    values.insert(key, readVector(in));
+  }
+  return values;
+}
+
+// Objects with polymorphic parts are written with a boost binary archive
+template <class T>
+void writeArchive(ostream& os, const T& object) {
+  const string archive = serializeBinary(object);
+  write<uint64_t>(os, archive.size());
+  os.write(archive.data(), archive.size());
+}
+
+template <class T>
+void readArchive(Input& in, T* object) {
+  string archive(readSize(in, 1), '\0');
+  in.is.read(&archive[0], archive.size());
+  if (!in.is)
+    throw invalid_argument("ISAM2::loadCheckpoint: truncated checkpoint");
+  try {
+    deserializeBinary(archive, *object);
+  } catch (const boost::archive::archive_exception& e) {
+    throw invalid_argument(string("ISAM2::loadCheckpoint: corrupt archive: ") +
+                           e.what());
+  }
+}
+
+/* ************************************************************************* */
+void writeModel(ostream& os, const SharedDiagonal& model) {
+  if (!model) {
+    write<uint8_t>(os, NO_MODEL);
+  } else if (model->isConstrained()) {
+    write<uint8_t>(os, CONSTRAINED_MODEL);
+    writeVector(os, model->sigmas());
+    writeVector(os,
+                boost::static_pointer_cast<noiseModel::Constrained>(model)->mu());
+  } else {
+    write<uint8_t>(os, DIAGONAL_MODEL);
+    writeVector(os, model->sigmas());
+  }
+}
+
+SharedDiagonal readModel(Input& in) {
+  switch (read<uint8_t>(in)) {
+    case NO_MODEL:
+      return SharedDiagonal();
+    case DIAGONAL_MODEL:
+      return noiseModel::Diagonal::Sigmas(readVector(in));
+    case CONSTRAINED_MODEL: {
+      const Vector sigmas = readVector(in);
+      return noiseModel::Constrained::MixedSigmas(readVector(in), sigmas);
+    }
+    default:
+      throw invalid_argument("ISAM2::loadCheckpoint: unknown noise model");
+  }
+}
+
+// Read the block dimensions of a block matrix, returning their sum.  The sum
+// can not exceed the bytes left, which holds for any matrix with entries.
+size_t readBlockDims(Input& in, vector<uint64_t>* dims) {
+  uint64_t sum = 0;
+  const uint64_t bytesLeft = in.bytesLeft();
+  for (uint64_t& dim : *dims) {
+    dim = read<uint64_t>(in);
+    if (dim > bytesLeft - sum)
+      throw invalid_argument("ISAM2::loadCheckpoint: corrupt size");
+    sum += dim;
+  }
+  return static_cast<size_t>(sum);
+}
+
+// The keys, block dimensions (including the right-hand side), rows, matrix
+// entries in column-major order, and noise model of a Jacobian factor
+void writeJacobian(ostream& os, const JacobianFactor& factor) {
+  const VerticalBlockMatrix& Ab = factor.matrixObject();
+  writeKeys(os, factor.keys());
+  for (DenseIndex block = 0; block < Ab.nBlocks(); ++block)
+    write<uint64_t>(os, Ab(block).cols());
+  write<uint64_t>(os, Ab.rows());
+  const auto full = Ab.full();
+  for (DenseIndex j = 0; j < full.cols(); ++j)
+    writeDoubles(os, full.col(j).data(), full.rows());
+  writeModel(os, factor.get_model());
+}
+
+// Read what writeJacobian wrote, returning the keys, matrix and noise model
+void readJacobian(Input& in, KeyVector* keys, VerticalBlockMatrix* Ab,
+                  SharedDiagonal* model) {
+  *keys = readKeys(in);
+  vector<uint64_t> dims(keys->size() + 1);
+  const size_t cols = readBlockDims(in, &dims);
+  const uint64_t rows = read<uint64_t>(in);
+  if (cols > 0 && rows > in.bytesLeft() / (cols * sizeof(double)))
+    throw invalid_argument("ISAM2::loadCheckpoint: corrupt size");
+  Matrix matrix(rows, cols);
+  readDoubles(in, matrix.data(), matrix.size());
+  *Ab = VerticalBlockMatrix(dims, matrix);
+  *model = readModel(in);
+}
+
+// The keys, block dimensions (including the right-hand side) and upper
+// triangle, column by column, of a Hessian factor
+void writeHessian(ostream& os, const HessianFactor& factor) {
+  const SymmetricBlockMatrix& info = factor.info();
+  writeKeys(os, factor.keys());
+  for (DenseIndex block = 0; block < info.nBlocks(); ++block)
+    write<uint64_t>(os, info.getDim(block));
+  const Matrix full = info.selfadjointView();
+  for (DenseIndex j = 0; j < full.cols(); ++j)
+    writeDoubles(os, full.col(j).data(), j + 1);
+}
+
+GaussianFactor::shared_ptr readHessian(Input& in) {
+  const KeyVector keys = readKeys(in);
+  vector<uint64_t> dims(keys.size() + 1);
+  const size_t n = readBlockDims(in, &dims);
+  // The upper triangle has n * (n + 1) / 2 entries
+  if (n > 0 && (n + 1) / 2 > in.bytesLeft() / sizeof(double) / n)
+    throw invalid_argument("ISAM2::loadCheckpoint: corrupt size");
+  Matrix upper(n, n);
+  for (size_t j = 0; j < n; ++j) readDoubles(in, upper.col(j).data(), j + 1);
+  SymmetricBlockMatrix info(dims);
+  info.setFullMatrix(upper);
+  return boost::make_shared<HessianFactor>(keys, info);
+}
+
+/* ************************************************************************* */
+// Factors other than Jacobian and Hessian factors are written as null if
+// \c unknownAsNull is set, or rejected otherwise
+void writeFactor(ostream& os, const GaussianFactor::shared_ptr& factor,
+                 bool unknownAsNull) {
+  if (!factor) {
+    write<uint8_t>(os, NULL_FACTOR);
+  } else if (auto jacobian =
+                 boost::dynamic_pointer_cast<JacobianFactor>(factor)) {
+    write<uint8_t>(os, JACOBIAN_FACTOR);
+    writeJacobian(os, *jacobian);
+  } else if (auto hessian = boost::dynamic_pointer_cast<HessianFactor>(factor)) {
+    write<uint8_t>(os, HESSIAN_FACTOR);
+    writeHessian(os, *hessian);
+  } else if (unknownAsNull) {
+    write<uint8_t>(os, NULL_FACTOR);
+  } else {
+    throw invalid_argument(
+        "ISAM2::saveCheckpoint: only Jacobian and Hessian factors can be "
+        "cached in the cliques of a checkpoint");
+  }
+}
+
+GaussianFactor::shared_ptr readFactor(Input& in) {
+  switch (read<uint8_t>(in)) {
+    case NULL_FACTOR:
+      return GaussianFactor::shared_ptr();
+    case JACOBIAN_FACTOR: {
+      KeyVector keys;
+      VerticalBlockMatrix Ab;
+      SharedDiagonal model;
+      readJacobian(in, &keys, &Ab, &model);
+      return boost::make_shared<JacobianFactor>(keys, Ab, model);
+    }
+    case HESSIAN_FACTOR:
+      return readHessian(in);
+    default:
+      throw invalid_argument("ISAM2::loadCheckpoint: unknown factor type");
+  }
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void ISAM2::saveCheckpoint(ostream& os) const {
+  gttic(saveCheckpoint);
+  os.write(checkpointMagic, sizeof(checkpointMagic));
+  write<uint32_t>(os, checkpointVersion);
+  write<uint32_t>(os, byteOrderMarker);
+  write<int64_t>(os, update_count_);
+  write<uint8_t>(os, doglegDelta_ ? 1 : 0);
+  write<double>(os, doglegDelta_ ? *doglegDelta_ : 0.0);
+
+  // Nonlinear state
+  writeArchive(os, theta_);
+  writeArchive(os, nonlinearFactors_);
+  writeKeys(os, fixedVariables_);
+  writeKeys(os, deferredRelinKeys_);
+  write<uint64_t>(os, addedVariables_.size());
+  for (const auto& update_keys : addedVariables_) {
+    write<int64_t>(os, update_keys.first);
+    writeKeys(os, update_keys.second);
+  }
+
+  // Linear state, linear factors that can not be written are relinearized
+  // when loading
+  writeVectorValues(os, delta_);
+  writeVectorValues(os, deltaNewton_);
+  writeVectorValues(os, RgProd_);
+  writeKeys(os, deltaReplacedMask_);
+  write<uint64_t>(os, linearFactors_.size());
+  for (const auto& factor : linearFactors_) writeFactor(os, factor, true);
+
+  // The cliques in breadth-first order, each after its parent
+  vector<sharedClique> cliques(roots_.begin(), roots_.end());
+  FastMap<const Clique*, int64_t> indices;
+  for (size_t i = 0; i < cliques.size(); ++i)
+    cliques.insert(cliques.end(), cliques[i]->children.begin(),
+                   cliques[i]->children.end());
+  write<uint64_t>(os, cliques.size());
+  for (size_t i = 0; i < cliques.size(); ++i) {
+    const Clique& clique = *cliques[i];
+    indices[&clique] = i;
+    const sharedClique parent = clique.parent();
+    write<int64_t>(os, parent ? indices.at(parent.get()) : -1);
+    write<int32_t>(os, clique.problemSize_);
+    write<uint64_t>(os, clique.conditional()->nrFrontals());
+    writeJacobian(os, *clique.conditional());
+    writeFactor(os, clique.cachedFactor_, false);
+    writeVector(os, clique.gradientContribution_);
+  }
+  if (!os) throw runtime_error("ISAM2::saveCheckpoint: could not write");
+}
+
+/* ************************************************************************* */
+void ISAM2::loadCheckpoint(istream& is) {
+  gttic(loadCheckpoint);
+  Input in(is);
+  char magic[sizeof(checkpointMagic)];
+  is.read(magic, sizeof(magic));
+  if (!is || memcmp(magic, checkpointMagic, sizeof(magic)) != 0)
+    throw invalid_argument("ISAM2::loadCheckpoint: not an ISAM2 checkpoint");
+  if (read<uint32_t>(in) != checkpointVersion)
+    throw invalid_argument("ISAM2::loadCheckpoint: unsupported checkpoint version");
+  if (read<uint32_t>(in) != byteOrderMarker)
+    throw invalid_argument(
+        "ISAM2::loadCheckpoint: checkpoint written with another byte order");
+
+  // Everything is read into locals first, so that this instance is unchanged
+  // if the checkpoint turns out to be invalid
+  const int updateCount = static_cast<int>(read<int64_t>(in));
+  const bool hasDoglegDelta = read<uint8_t>(in) != 0;
+  const double doglegDelta = read<double>(in);
+
+  // Nonlinear state
+  Values theta;
+  readArchive(in, &theta);
+  NonlinearFactorGraph nonlinearFactors;
+  readArchive(in, &nonlinearFactors);
+  KeySet fixedVariables = readKeySet(in);
+  KeySet deferredRelinKeys = readKeySet(in);
+  std::deque<std::pair<int, KeyVector> > addedVariables(
+      readSize(in, 2 * sizeof(uint64_t)));
+  for (auto& update_keys : addedVariables) {
+    update_keys.first = static_cast<int>(read<int64_t>(in));
+    update_keys.second = readKeys(in);
+  }
+
+  // Linear state
+  VectorValues delta = readVectorValues(in);
+  VectorValues deltaNewton = readVectorValues(in);
+  VectorValues RgProd = readVectorValues(in);
+  KeySet deltaReplacedMask = readKeySet(in);
+  GaussianFactorGraph linearFactors;
+  linearFactors.resize(readSize(in, sizeof(uint8_t)));
+  for (size_t i = 0; i < linearFactors.size(); ++i) {
+    linearFactors[i] = readFactor(in);
+    if (!linearFactors[i] && i < nonlinearFactors.size() &&
+        nonlinearFactors[i] && params_.cacheLinearizedFactors)
+      linearFactors[i] = nonlinearFactors[i]->linearize(theta);
+  }
+
+  // The cliques of the Bayes tree, each after its parent
+  vector<sharedClique> cliques(readSize(in, sizeof(int64_t)));
+  vector<int64_t> parents(cliques.size());
+  for (size_t i = 0; i < cliques.size(); ++i) {
+    parents[i] = read<int64_t>(in);
+    if (parents[i] >= static_cast<int64_t>(i))
+      throw invalid_argument("ISAM2::loadCheckpoint: invalid clique parent");
+    auto clique = boost::make_shared<Clique>();
+    clique->problemSize_ = read<int32_t>(in);
+    const uint64_t nrFrontals = read<uint64_t>(in);
+    KeyVector keys;
+    VerticalBlockMatrix Rd;
+    SharedDiagonal model;
+    readJacobian(in, &keys, &Rd, &model);
+    if (nrFrontals == 0 || nrFrontals > keys.size())
+      throw invalid_argument(
+          "ISAM2::loadCheckpoint: invalid number of frontal variables");
+    clique->conditional_ = boost::make_shared<GaussianConditional>(
+        keys, static_cast<size_t>(nrFrontals), Rd, model);
+    clique->cachedFactor_ = readFactor(in);
+    clique->gradientContribution_ = readVector(in);
+    cliques[i] = clique;
+  }
+
+  // The checkpoint is valid, replace the state
+  update_count_ = updateCount;
+  doglegDelta_ = hasDoglegDelta ? boost::optional<double>(doglegDelta)
+                                : boost::none;
+  theta_.swap(theta);
+  nonlinearFactors_ = nonlinearFactors;
+  variableIndex_ = VariableIndex(nonlinearFactors_);
+  fixedVariables_.swap(fixedVariables);
+  deferredRelinKeys_.swap(deferredRelinKeys);
+  addedVariables_.swap(addedVariables);
+  delta_.swap(delta);
+  deltaNewton_.swap(deltaNewton);
+  RgProd_.swap(RgProd);
+  deltaReplacedMask_.swap(deltaReplacedMask);
+  linearFactors_ = linearFactors;
+  Base::clear();
+  for (size_t i = 0; i < cliques.size(); ++i)
+    addClique(cliques[i], parents[i] < 0 ? sharedClique() : cliques[parents[i]]);
+
+  // Nothing derived from the previous state is kept
+  relinearizationJob_.reset();
+  reorderingJob_.reset();
+  for (EstimateBuffer& buffer : estimateBuffers_) buffer = EstimateBuffer();
+  estimateSnapshot_.store(boost::shared_ptr<const Values>());
+  if (params_.publishEstimates) publishEstimate();
+}
+
+}  // namespace gtsam
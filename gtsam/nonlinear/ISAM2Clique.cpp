@@ -19,6 +19,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/linearAlgorithms-inst.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
+#include <gtsam/base/TaskGroup.h>
 
 #include <stack>
 #include <utility>
@@ -208,7 +209,7 @@ void ISAM2Clique::optimizeWildfire(const KeySet& replaced, double threshold,
 
     // Back-substitute
     fastBackSubstitute(delta);
-    count += conditional_->nrFrontals();
+    *count += conditional_->nrFrontals();
 
     if (valuesChanged(replaced, originalValues, *delta, threshold)) {
       markFrontalsAsChanged(changed);
@@ -245,7 +246,7 @@ bool ISAM2Clique::optimizeWildfireNode(const KeySet& replaced, double threshold,
 
     // Back-substitute
     fastBackSubstitute(delta);
-    count += conditional_->nrFrontals();
+    *count += conditional_->nrFrontals();
 
     if (valuesChanged(replaced, originalValues, *delta, threshold)) {
       markFrontalsAsChanged(changed);
@@ -283,6 +284,90 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
   return count;
 }
 
+/* ************************************************************************* */
+bool ISAM2Clique::optimizeWildfireNodeConcurrent(
+    const KeySet& replaced, double threshold, KeySet* changed,
+    std::mutex* changedMutex, VectorValues* delta,
+    std::atomic<size_t>* count) const {
+  bool dirty;
+  {
+    std::lock_guard<std::mutex> lock(*changedMutex);
+    dirty = isDirty(replaced, *changed);
+  }
+  if (dirty) {
+    // Temporary copy of the original values, to check how much they change
+    auto originalValues = delta->vector(conditional_->frontals());
+
+    // Back-substitute, writing the solution to the existing entries of delta,
+    // as VectorValues::update would modify the container
+    const VectorValues solution = conditional_->solve(*delta);
+    for (const auto& key_value : solution)
+      delta->at(key_value.first) = key_value.second;
+    *count += conditional_->nrFrontals();
+
+    if (valuesChanged(replaced, originalValues, *delta, threshold)) {
+      std::lock_guard<std::mutex> lock(*changedMutex);
+      markFrontalsAsChanged(changed);
+    } else {
+      restoreFromOriginals(originalValues, delta);
+    }
+  }
+
+  return dirty;
+}
+
+namespace {
+/// Shared state of a parallel wildfire
+struct WildfireParallel {
+  const KeySet& replaced;
+  double threshold;
+  VectorValues* delta;
+  KeySet changed;
+  std::mutex changedMutex;
+  std::atomic<size_t> count;
+
+  WildfireParallel(const KeySet& replaced, double threshold,
+                   VectorValues* delta)
+      : replaced(replaced), threshold(threshold), delta(delta), count(0) {}
+
+  // Back-substitute the subtree of clique.  Children that are leaves, and the
+  // first child with children of its own, stay in this task; the other
+  // children become new tasks once the clique is solved.
+  void process(const ISAM2Clique::shared_ptr& clique) {
+    TaskGroup group;
+    std::stack<ISAM2Clique::shared_ptr> travStack;
+    travStack.push(clique);
+    while (!travStack.empty()) {
+      const ISAM2Clique::shared_ptr currentNode = travStack.top();
+      travStack.pop();
+      bool dirty = currentNode->optimizeWildfireNodeConcurrent(
+          replaced, threshold, &changed, &changedMutex, delta, &count);
+      if (dirty) {
+        bool keptSubtree = false;
+        for (const auto& child : currentNode->children) {
+          if (child->children.empty() || !keptSubtree) {
+            keptSubtree = keptSubtree || !child->children.empty();
+            travStack.push(child);
+          } else {
+            group.run([this, child]() { process(child); });
+          }
+        }
+      }
+    }
+    group.wait();
+  }
+};
+}  // namespace
+
+size_t optimizeWildfireParallel(const ISAM2Clique::shared_ptr& root,
+                                double threshold, const KeySet& keys,
+                                VectorValues* delta) {
+  if (!root) return 0;
+  WildfireParallel wildfire(keys, threshold, delta);
+  wildfire.process(root);
+  return wildfire.count;
+}
+
 /* ************************************************************************* */
 void ISAM2Clique::nnz_internal(size_t* result) const {
   size_t dimR = conditional_->rows();
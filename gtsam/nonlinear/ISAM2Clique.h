@@ -24,6 +24,9 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianConditional.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+
+#include <atomic>
+#include <mutex>
 #include <string>
 
 namespace gtsam {
@@ -95,6 +98,17 @@ class GTSAM_EXPORT ISAM2Clique
                             KeySet* changed, VectorValues* delta,
                             size_t* count) const;
 
+  /**
+   * Same as optimizeWildfireNode, but may run concurrently for cliques that are
+   * not ancestors of each other: \c changed is only accessed with \c
+   * changedMutex locked, and the frontal entries of \c delta, which must
+   * already exist, are overwritten in place.
+   */
+  bool optimizeWildfireNodeConcurrent(const KeySet& replaced, double threshold,
+                                      KeySet* changed, std::mutex* changedMutex,
+                                      VectorValues* delta,
+                                      std::atomic<size_t>* count) const;
+
   /**
    * Starting from the root, add up entries of frontal and conditional matrices
    * of each conditional
@@ -174,4 +188,15 @@ size_t optimizeWildfireNonRecursive(const ISAM2Clique::shared_ptr& root,
                                     double threshold, const KeySet& replaced,
                                     VectorValues* delta);
 
+/**
+ * Parallel version of optimizeWildfireNonRecursive: once a clique is solved,
+ * the subtrees of its children are back-substituted in parallel tasks (see
+ * TaskGroup).  A clique only depends on its ancestors, so \c delta is the same
+ * as with the serial version.  All variables of the tree must already be in
+ * \c delta.
+ */
+size_t optimizeWildfireParallel(const ISAM2Clique::shared_ptr& root,
+                                double threshold, const KeySet& replaced,
+                                VectorValues* delta);
+
 }  // namespace gtsam
@@ -0,0 +1,224 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Marginals.cpp
+ * @brief   Marginal covariances of ISAM2 variables, cached between queries and
+ *          updates
+ * @date    Oct 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2Marginals.h>
+#include <gtsam/base/timing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace gtsam {
+
+namespace {
+
+/* ************************************************************************* */
+// Offset and dimension of variable j in the covariance of the variables of
+// conditional, which must contain j
+std::pair<DenseIndex, DenseIndex> position(
+    const GaussianConditional& conditional, Key j) {
+  DenseIndex offset = 0;
+  for (auto it = conditional.begin(); it != conditional.end(); ++it) {
+    const DenseIndex dim = conditional.getDim(it);
+    if (*it == j) return std::make_pair(offset, dim);
+    offset += dim;
+  }
+  throw std::invalid_argument("ISAM2Marginals: variable not in clique");
+}
+
+/* ************************************************************************* */
+// Copy the blocks of covariance, over the variables of conditional, that
+// correspond to variables into a dense matrix
+Matrix gather(const GaussianConditional& conditional, const Matrix& covariance,
+              const KeyVector& variables) {
+  std::vector<std::pair<DenseIndex, DenseIndex> > positions;
+  DenseIndex dim = 0;
+  for (Key j : variables) {
+    positions.push_back(position(conditional, j));
+    dim += positions.back().second;
+  }
+  Matrix result(dim, dim);
+  DenseIndex row = 0;
+  for (const auto& i : positions) {
+    DenseIndex col = 0;
+    for (const auto& j : positions) {
+      result.block(row, col, i.second, j.second) =
+          covariance.block(i.first, j.first, i.second, j.second);
+      col += j.second;
+    }
+    row += i.second;
+  }
+  return result;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+ISAM2Marginals::ISAM2Marginals(const ISAM2& isam)
+    : isam_(isam), nextGeneration_(1), nrVariables_(0) {}
+
+/* ************************************************************************* */
+Matrix ISAM2Marginals::marginalCovariance(Key variable) {
+  gttic(ISAM2Marginals_marginalCovariance);
+  const CliqueData& data = variableData(variable);
+  const auto pos = position(*data.conditional, variable);
+  return data.covariance.block(pos.first, pos.first, pos.second, pos.second);
+}
+
+/* ************************************************************************* */
+FastMap<Key, Matrix> ISAM2Marginals::marginalCovariances(
+    const KeyVector& variables) {
+  FastMap<Key, Matrix> result;
+  for (Key j : variables) result.emplace(j, marginalCovariance(j));
+  return result;
+}
+
+/* ************************************************************************* */
+JointMarginal ISAM2Marginals::jointMarginalCovariance(
+    const KeyVector& variables) {
+  gttic(ISAM2Marginals_jointMarginalCovariance);
+  // The joint marginal is returned with sorted keys, as by Marginals
+  KeyVector variablesSorted = variables;
+  std::sort(variablesSorted.begin(), variablesSorted.end());
+  std::vector<size_t> dims;
+  for (Key j : variablesSorted)
+    dims.push_back(isam_.getLinearizationPoint().at(j).dim());
+
+  // If the variables are all in the clique of one of them, take the blocks of
+  // its covariance
+  for (Key j : variablesSorted) {
+    const GaussianConditional& conditional = *isam_.clique(j)->conditional();
+    const bool all = std::all_of(
+        variablesSorted.begin(), variablesSorted.end(), [&](Key k) {
+          return std::find(conditional.begin(), conditional.end(), k) !=
+                 conditional.end();
+        });
+    if (all)
+      return JointMarginal(
+          gather(conditional, variableData(j).covariance, variablesSorted),
+          dims, variablesSorted);
+  }
+
+  // Otherwise, the conditionals of the cliques on the paths to the root form
+  // a Bayes net on the variables of these cliques, which we marginalize
+  KeySet visited;
+  GaussianFactorGraph paths;
+  for (Key j : variablesSorted) {
+    for (ISAM2::sharedClique clique = isam_.clique(j); clique;
+         clique = clique->parent()) {
+      if (!visited.insert(clique->conditional()->front()).second) break;
+      paths.push_back(clique->conditional());
+    }
+  }
+  const Ordering ordering(variablesSorted);
+  const Matrix information =
+      GaussianFactorGraph(
+          *paths.marginalMultifrontalBayesNet(
+              ordering, isam_.params().getEliminationFunction()))
+          .hessian(ordering)
+          .first;
+  return JointMarginal(information.inverse(), dims, variablesSorted);
+}
+
+/* ************************************************************************* */
+void ISAM2Marginals::clear() {
+  cliques_.clear();
+  roots_.clear();
+}
+
+/* ************************************************************************* */
+void ISAM2Marginals::refresh() {
+  std::vector<GaussianConditional::shared_ptr> roots;
+  roots.reserve(isam_.roots().size());
+  for (const ISAM2::sharedClique& root : isam_.roots())
+    roots.push_back(root->conditional());
+  if (roots == roots_ && nrVariables_ == isam_.nodes().size()) return;
+
+  gttic(ISAM2Marginals_refresh);
+  for (auto it = cliques_.begin(); it != cliques_.end();) {
+    const auto node = isam_.nodes().find(it->first);
+    if (node == isam_.nodes().end() ||
+        node->second->conditional() != it->second.conditional)
+      it = cliques_.erase(it);
+    else
+      ++it;
+  }
+  roots_.swap(roots);
+  nrVariables_ = isam_.nodes().size();
+}
+
+/* ************************************************************************* */
+const ISAM2Marginals::CliqueData& ISAM2Marginals::cliqueData(
+    const ISAM2::sharedClique& clique) {
+  refresh();
+
+  // The covariance of a clique depends on those of all its ancestors, so walk
+  // down from the root, bringing the data of each clique up to date
+  std::vector<ISAM2::sharedClique> path;
+  for (ISAM2::sharedClique c = clique; c; c = c->parent()) path.push_back(c);
+
+  const CliqueData* parentData = nullptr;
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    const GaussianConditional::shared_ptr& conditional = (*it)->conditional();
+    CliqueData& data = cliques_[conditional->front()];
+
+    // Factors that only depend on the conditional
+    if (data.conditional != conditional) {
+      gttic(ISAM2Marginals_cliqueFactors);
+      Matrix R = conditional->R();
+      Matrix S = conditional->S();
+      if (conditional->get_model()) {
+        R = conditional->get_model()->Whiten(R);
+        S = conditional->get_model()->Whiten(S);
+      }
+      const Matrix Rinv = R.triangularView<Eigen::Upper>().solve(
+          Matrix::Identity(R.rows(), R.rows()));
+      data.conditional = conditional;
+      data.RinvRinvT = Rinv * Rinv.transpose();
+      data.G = Rinv * S;
+      data.generation = 0;
+    }
+
+    // Covariance, from the covariance of the separator if this is not a root
+    const size_t parentGeneration = parentData ? parentData->generation : 0;
+    if (data.generation == 0 || data.parentGeneration != parentGeneration) {
+      gttic(ISAM2Marginals_cliqueCovariance);
+      const DenseIndex nF = data.G.rows(), nS = data.G.cols();
+      data.covariance.resize(nF + nS, nF + nS);
+      if (nS == 0) {
+        data.covariance = data.RinvRinvT;
+      } else {
+        const KeyVector separator(conditional->beginParents(),
+                                  conditional->endParents());
+        const Matrix covSS = gather(*parentData->conditional,
+                                    parentData->covariance, separator);
+        const Matrix covFS = -data.G * covSS;
+        data.covariance.topLeftCorner(nF, nF) =
+            data.RinvRinvT - covFS * data.G.transpose();
+        data.covariance.topRightCorner(nF, nS) = covFS;
+        data.covariance.bottomLeftCorner(nS, nF) = covFS.transpose();
+        data.covariance.bottomRightCorner(nS, nS) = covSS;
+      }
+      data.generation = nextGeneration_++;
+      data.parentGeneration = parentGeneration;
+    }
+    parentData = &data;
+  }
+  return *parentData;
+}
+
+}  // namespace gtsam
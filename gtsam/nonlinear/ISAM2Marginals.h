@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Marginals.h
+ * @brief   Marginal covariances of ISAM2 variables, cached between queries and
+ *          updates
+ * @date    Oct 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/Marginals.h>
+
+namespace gtsam {
+
+/**
+ * Recovers marginal covariances of the variables of an ISAM2 instance from its
+ * Bayes tree, top-down: the joint covariance of the frontal and separator
+ * variables of a clique is computed from the conditional of the clique and the
+ * joint covariance of its separator, which is part of the one of its parent
+ * clique.  Both the clique covariances and the factors that only depend on the
+ * conditional of a clique are cached, so that queries share the work done for
+ * the ancestors of their cliques.
+ *
+ * ISAM2::update() may be called between queries.  The cached data of a clique
+ * is recomputed when its conditional has been re-eliminated, i.e. when the
+ * clique was in the top of the Bayes tree that the update replaced, and its
+ * covariance is recomputed if the covariance of an ancestor changed (which is
+ * the case after any update that re-eliminates the root).  The factors of the
+ * untouched cliques are kept, and the data of the cliques that were removed
+ * from the Bayes tree, e.g. by an update or by marginalizeLeaves, is dropped.
+ *
+ * This class is not thread-safe, and keeps a reference to the ISAM2 instance.
+ */
+class GTSAM_EXPORT ISAM2Marginals {
+ public:
+  /** Construct for \c isam, which must outlive this object */
+  explicit ISAM2Marginals(const ISAM2& isam);
+
+  /** Compute the marginal covariance of a single variable */
+  Matrix marginalCovariance(Key variable);
+
+  /** Compute the marginal covariances of several variables, sharing the work
+   * for common ancestor cliques */
+  FastMap<Key, Matrix> marginalCovariances(const KeyVector& variables);
+
+  /** Compute the joint marginal covariance of several variables.  This is
+   * cheap if all variables are in one clique (as frontal or separator
+   * variables), otherwise the marginal is computed from the conditionals of
+   * the cliques on the paths from the variables to the root. */
+  JointMarginal jointMarginalCovariance(const KeyVector& variables);
+
+  /** Forget all cached data */
+  void clear();
+
+  /** The number of cliques with cached data */
+  size_t nrCachedCliques() const { return cliques_.size(); }
+
+ private:
+  /// The cached data of a clique
+  struct CliqueData {
+    GaussianConditional::shared_ptr conditional;  ///< The conditional this is
+                                                  ///< computed for
+    Matrix RinvRinvT;  ///< R^-1 R^-T, with R whitened
+    Matrix G;          ///< R^-1 S, with R and S whitened
+    Matrix covariance;  ///< The joint covariance of the frontal and separator
+                        ///< variables, in the order of the conditional
+    size_t generation = 0;  ///< Identifies the covariance, 0 if not computed
+    size_t parentGeneration = 0;  ///< Generation of the parent covariance it
+                                  ///< was computed from
+  };
+
+  /// The cached data of \c clique, with an up-to-date covariance
+  const CliqueData& cliqueData(const ISAM2::sharedClique& clique);
+
+  /// Drop the cached data of the cliques that are no longer in the Bayes tree,
+  /// if it changed since the last call
+  void refresh();
+
+  /// The cached data of the clique of \c variable, with an up-to-date
+  /// covariance
+  const CliqueData& variableData(Key variable) {
+    return cliqueData(isam_.clique(variable));
+  }
+
+  const ISAM2& isam_;
+  FastMap<Key, CliqueData> cliques_;  ///< By first frontal variable
+  size_t nextGeneration_;
+
+  /// The root conditionals and number of variables at the last refresh().  Any
+  /// update that changes a clique re-eliminates the root, and marginalizing or
+  /// removing variables changes their number.
+  std::vector<GaussianConditional::shared_ptr> roots_;
+  size_t nrVariables_;
+};
+
+}  // namespace gtsam
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <gtsam/config.h>
+#include <gtsam/inference/Ordering.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <boost/variant.hpp>
@@ -223,6 +225,71 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** Whether to publish a snapshot of the estimate at the end of each update
+   * (default: false).  Snapshots are immutable and can be obtained with
+   * ISAM2::estimateSnapshot() from any thread, also while the next update
+   * runs.  This forces the back-substitution in every update, which is
+   * otherwise only done when the delta is needed.
+   */
+  bool publishEstimates;
+
+  /** Whether to relinearize in the background (default: false).  When
+   * relinearization is due, the variables above the threshold are not
+   * relinearized in that update: their new linearization points and the
+   * factors involving them are linearized on a background thread, from a
+   * snapshot of the linearization point, and swapped in by the first update
+   * that finds them ready.  Only this update re-eliminates the cliques of the
+   * relinearized variables, and no new relinearization is started while one
+   * runs.  Relinearized factors are only reused if cacheLinearizedFactors is
+   * set, and a forced relinearization (ISAM2UpdateParams::force_relinearize)
+   * waits for the background one.  The background task linearizes clones of
+   * the factors, so that factors with mutable caches are not shared between
+   * threads: if any of the factors does not implement clone(), or
+   * TaskGroup::MaxConcurrency() is 1, they are linearized in the update that
+   * starts the relinearization, and still swapped in by the next one.  If a
+   * factor throws while it is linearized in the background, the update that
+   * finds the relinearization done rethrows the exception and drops it.
+   */
+  bool backgroundRelinearization;
+
+  /** Re-eliminate the whole Bayes tree with a fresh ordering every
+   * batchReorderInterval updates (default: 0, never).  Incremental updates
+   * only reorder the top of the tree, with the new variables last, which lets
+   * fill accumulate over long trajectories.  The ordering of all variables is
+   * computed in a TaskGroup from a snapshot of the factors, and the first
+   * update that finds it ready re-eliminates the tree in batch with it,
+   * ordering the variables added in the meantime last.  Only the ordering is
+   * computed in the background: the re-elimination of the whole tree runs in
+   * that update, which takes as long as a batch elimination.  If
+   * TaskGroup::MaxConcurrency() is 1, the ordering is computed in the update
+   * that starts it.  An update with ISAM2UpdateParams::constrainedKeys keeps
+   * its own ordering and leaves the background one for the next update.  If
+   * computing the ordering failed, the next update throws its exception before
+   * changing any state, and drops the background job.
+   */
+  int batchReorderInterval;
+
+  /** The ordering used for batch reorders (default: Ordering::METIS, nested
+   * dissection, if GTSAM is compiled with it, Ordering::COLAMD otherwise), see
+   * batchReorderInterval */
+  Ordering::OrderingType batchReorderingType;
+
+  /** Whether to compute the fill statistics of the Bayes tree after each
+   * update, to return in ISAM2Result::fill from update() (default: false) */
+  bool evaluateFillStatistics;
+
+  /** Marginalize the variables added more than marginalizationLag updates ago
+   * (default: 0, never), to bound memory and update time in lifelong
+   * operation.  The update in which variables leave the window reorders them
+   * to the leaves of the Bayes tree, with ordering constraints, and then
+   * marginalizes them with ISAM2::marginalizeLeaves(), replacing their factors
+   * by linear marginal factors on the remaining variables, whose
+   * linearization points become fixed.  Set findUnusedFactorSlots as well, so
+   * that later marginal factors and new factors reuse the slots of the removed
+   * factors and the factor storage stays bounded.
+   */
+  int marginalizationLag;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +313,17 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(_enableDetailedResults),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        publishEstimates(false),
+        backgroundRelinearization(false),
+        batchReorderInterval(0),
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+        batchReorderingType(Ordering::METIS),
+#else
+        batchReorderingType(Ordering::COLAMD),
+#endif
+        evaluateFillStatistics(false),
+        marginalizationLag(0) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +365,17 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "publishEstimates:                  " << publishEstimates << "\n";
+    cout << "backgroundRelinearization:         " << backgroundRelinearization
+         << "\n";
+    cout << "batchReorderInterval:              " << batchReorderInterval
+         << "\n";
+    cout << "batchReorderingType:               " << batchReorderingType
+         << "\n";
+    cout << "evaluateFillStatistics:            " << evaluateFillStatistics
+         << "\n";
+    cout << "marginalizationLag:                " << marginalizationLag
+         << "\n";
     cout.flush();
   }
 
@@ -75,6 +75,14 @@ struct ISAM2Result {
    */
   size_t variablesRelinearized;
 
+  /** The number of variables whose linear deltas crossed the relinearization
+   * threshold in the relinearization check of this update, after removing
+   * fixed variables but before deferring those over
+   * ISAM2UpdateParams::maxRelinearizedVariables.  On steps where no
+   * relinearization is checked, this count will be zero.
+   */
+  size_t variablesAboveRelinThreshold;
+
   /** The number of variables that were reeliminated as parts of the Bayes'
    * Tree were recalculated, due to new factors.  When loop closures occur,
    * this count will be large as the new loop-closing factors will tend to
@@ -90,6 +98,23 @@ struct ISAM2Result {
   /** The number of cliques in the Bayes' Tree */
   size_t cliques;
 
+  /** Whether the whole Bayes tree was re-eliminated with an ordering computed
+   * in the background, see ISAM2Params::batchReorderInterval */
+  bool batchReordered;
+
+  /** Fill statistics of the Bayes tree */
+  struct FillStatistics {
+    size_t nnz;             ///< Entries in the upper-triangular conditionals
+    size_t maxCliqueSize;   ///< Variables in the largest clique
+    double meanCliqueSize;  ///< Mean number of variables in a clique
+  };
+
+  /** The fill statistics of the Bayes tree after the update, which will only
+   * be computed if ISAM2Params::evaluateFillStatistics is set to \c true,
+   * because this requires a traversal of the whole tree.
+   */
+  boost::optional<FillStatistics> fill;
+
   /** The indices of the newly-added factors, in 1-to-1 correspondence with the
    * factors passed as \c newFactors to ISAM2::update().  These indices may be
    * used later to refer to the factors in order to remove them.
@@ -110,6 +135,14 @@ struct ISAM2Result {
   /** All keys that were marked during the update process. */
   KeySet markedKeys;
 
+  /** Keys that were marginalized at the end of the update because they left
+   * the window of ISAM2Params::marginalizationLag. */
+  KeyVector marginalizedKeys;
+
+  /** Keys above the relinearization threshold that were not relinearized
+   * because of ISAM2UpdateParams::maxRelinearizedVariables. */
+  KeySet deferredRelinKeys;
+
   /**
    * A struct holding detailed results, which must be enabled with
    * ISAM2Params::enableDetailedResults.
@@ -69,6 +69,18 @@ struct ISAM2UpdateParams {
    * the deltas become too small down in the tree. This flagg forces a full
    * solve instead. */
   bool forceFullSolve{false};
+
+  /** Maximum number of variables to relinearize in this update, or 0 for no
+   * limit (default: 0).  This bounds the relinearization work of an update,
+   * for applications that need bounded latency more than immediate
+   * relinearization.  If more variables exceed the relinearization threshold,
+   * those with the largest deltas (relative to the threshold) are relinearized,
+   * and the others are deferred: they are reported in
+   * ISAM2Result::deferredRelinKeys, and checked again in the next update even
+   * if it would not check for relinearization otherwise (see
+   * ISAM2Params::relinearizeSkip).  Variables relinearized because they are
+   * involved with a relinearized variable are not counted. */
+  size_t maxRelinearizedVariables{0};
 };
 
 }  // namespace gtsam
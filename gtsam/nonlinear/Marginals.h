@@ -196,6 +196,7 @@ protected:
     blockMatrix_(dims, fullMatrix), keys_(keys), indices_(Ordering(keys).invert()) {}
 
   friend class Marginals;
+  friend class ISAM2Marginals;
 
 };
 
@@ -167,6 +167,13 @@ public:
         new JacobianFactor(this->key(), A, b, model));
   }
 
+  /// Linearization is specialized above, so always call linearize()
+  virtual void linearizeInPlace(const Values& x,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& /*workspace*/) const {
+    linearFactor = linearize(x);
+  }
+
   /// @return a deep copy of this factor
   virtual gtsam::NonlinearFactor::shared_ptr clone() const {
     return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -163,6 +163,47 @@ boost::shared_ptr<GaussianFactor> NoiseModelFactor::linearize(
     return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
 }
 
+/* ************************************************************************* */
+void NoiseModelFactor::linearizeInPlace(const Values& x,
+    boost::shared_ptr<GaussianFactor>& linearFactor,
+    LinearizationWorkspace& workspace) const {
+
+  // We can only overwrite a JacobianFactor nobody else is looking at, that
+  // has our keys and dimension, and carries a noise model iff we are
+  // constrained, and only if linearize() is the generic one
+  JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(linearFactor.get());
+  const bool constrained = noiseModel_ && noiseModel_->isConstrained();
+  if (!usesGenericLinearize() || !jacobian || !linearFactor.unique() || !active(x)
+      || jacobian->keys() != keys() || jacobian->rows() != dim()
+      || bool(jacobian->get_model()) != constrained) {
+    linearFactor = linearize(x);
+    return;
+  }
+
+  // Evaluate into the buffers of the caller, which keep their size between
+  // calls
+  std::vector<Matrix>& A = workspace.A;
+  Vector& b = workspace.b;
+  A.resize(size());
+  b = -unwhitenedError(x, A);
+  check(noiseModel_, b.size());
+
+  // Whiten the corresponding system now
+  if (noiseModel_)
+    noiseModel_->WhitenSystem(A, b);
+
+  // Overwrite the blocks of the previous linearization
+  for (size_t j = 0; j < size(); ++j) {
+    JacobianFactor::ABlock block = jacobian->getA(jacobian->begin() + j);
+    if (block.cols() != A[j].cols()) {
+      linearFactor = linearize(x);
+      return;
+    }
+    block = A[j];
+  }
+  jacobian->getb() = b;
+}
+
 /* ************************************************************************* */
 
 } // \namespace gtsam
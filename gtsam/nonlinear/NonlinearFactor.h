@@ -42,6 +42,19 @@ using boost::assign::cref_list_of;
 
 /* ************************************************************************* */
 
+/**
+ * Buffers that NonlinearFactor::linearizeInPlace evaluates into, owned by the
+ * caller and reused for all the factors it linearizes.  A factor that
+ * linearizes other factors in place while it is being linearized has to pass
+ * them a workspace of its own.
+ */
+struct LinearizationWorkspace {
+  std::vector<Matrix> A;  ///< The unwhitened Jacobians
+  Vector b;               ///< The unwhitened negative error
+};
+
+/* ************************************************************************* */
+
 /**
  * Nonlinear factor base class
  *
@@ -116,6 +129,19 @@ public:
   virtual boost::shared_ptr<GaussianFactor>
   linearize(const Values& c) const = 0;
 
+  /**
+   * Linearize into \c linearFactor, which holds the result of a previous
+   * linearization of this factor (or is empty). Subclasses can overwrite the
+   * storage of the previous factor instead of allocating a new one, as long
+   * as \c linearFactor is not shared, and evaluate into the buffers of
+   * \c workspace. The default calls linearize().
+   */
+  virtual void linearizeInPlace(const Values& c,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& /*workspace*/) const {
+    linearFactor = linearize(c);
+  }
+
   /**
    * Creates a shared_ptr clone of the factor - needs to be specialized to allow
    * for subclasses
@@ -251,6 +277,27 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+  /**
+   * Linearize, overwriting the JacobianFactor from a previous linearization
+   * if it is not shared and has the same shape. The Jacobians are evaluated
+   * into the buffers of \c workspace, so that re-linearizing a factor does
+   * not allocate new matrices. This is only done for factors whose
+   * usesGenericLinearize() is true, the others are linearized with
+   * linearize().
+   */
+  void linearizeInPlace(const Values& x,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& workspace) const;
+
+  /**
+   * Whether the concrete class of this factor linearizes with the linearize()
+   * above, so that linearizeInPlace() can evaluate it into a previous
+   * linearization. False by default, as subclasses may override linearize().
+   * Since an override is inherited, a class that opts in checks that it is the
+   * concrete class, as in `return typeid(*this) == typeid(This);`.
+   */
+  virtual bool usesGenericLinearize() const { return false; }
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -314,6 +314,29 @@ public:
     }
   }
 };
+
+class _LinearizeOneFactorInPlace {
+  const NonlinearFactorGraph& nonlinearGraph_;
+  const Values& linearizationPoint_;
+  GaussianFactorGraph& result_;
+public:
+  // Create functor with constant parameters
+  _LinearizeOneFactorInPlace(const NonlinearFactorGraph& graph,
+      const Values& linearizationPoint, GaussianFactorGraph& result) :
+      nonlinearGraph_(graph), linearizationPoint_(linearizationPoint), result_(result) {
+  }
+  // Operator that re-linearizes a given range of the factors
+  void operator()(const tbb::blocked_range<size_t>& blocked_range) const {
+    LinearizationWorkspace workspace;
+    for (size_t i = blocked_range.begin(); i != blocked_range.end(); ++i) {
+      if (nonlinearGraph_[i])
+        nonlinearGraph_[i]->linearizeInPlace(linearizationPoint_, result_[i],
+                                             workspace);
+      else
+        result_[i] = GaussianFactor::shared_ptr();
+    }
+  }
+};
 #endif
 
 }
@@ -350,6 +373,34 @@ GaussianFactorGraph::shared_ptr NonlinearFactorGraph::linearize(const Values& li
   return linearFG;
 }
 
+/* ************************************************************************* */
+void NonlinearFactorGraph::linearizeInPlace(const Values& linearizationPoint,
+                                            GaussianFactorGraph& linearFG) const
+{
+  gttic(NonlinearFactorGraph_linearizeInPlace);
+
+  // Factors beyond the previous linearization start out empty
+  linearFG.resize(size());
+
+#ifdef GTSAM_USE_TBB
+
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+    _LinearizeOneFactorInPlace(*this, linearizationPoint, linearFG));
+
+#else
+
+  LinearizationWorkspace workspace;
+  for (size_t i = 0; i < size(); ++i) {
+    if (factors_[i])
+      factors_[i]->linearizeInPlace(linearizationPoint, linearFG[i], workspace);
+    else
+      linearFG[i] = GaussianFactor::shared_ptr();
+  }
+
+#endif
+}
+
 /* ************************************************************************* */
 static Scatter scatterFromValues(const Values& values) {
   gttic(scatterFromValues);
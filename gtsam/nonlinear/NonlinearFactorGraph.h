@@ -145,6 +145,15 @@ namespace gtsam {
     /// Linearize a nonlinear factor graph
     boost::shared_ptr<GaussianFactorGraph> linearize(const Values& linearizationPoint) const;
 
+    /**
+     * Linearize a nonlinear factor graph into an existing GaussianFactorGraph,
+     * typically the result of linearizing this graph before. Factors that are
+     * not shared with anyone else are overwritten in place instead of being
+     * re-allocated (see NonlinearFactor::linearizeInPlace), so that repeated
+     * linearization of a graph with fixed structure does not allocate.
+     */
+    void linearizeInPlace(const Values& linearizationPoint, GaussianFactorGraph& linearFG) const;
+
     /// typdef for dampen functions used below
     typedef std::function<void(const boost::shared_ptr<HessianFactor>& hessianFactor)> Dampen;
 
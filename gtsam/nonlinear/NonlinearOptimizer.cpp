@@ -22,17 +22,22 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/SupernodalCholesky.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
 #include <gtsam/inference/Ordering.h>
 
+#include <gtsam/base/EliminationArena.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 
 using namespace std;
 
@@ -87,12 +92,19 @@ void NonlinearOptimizer::defaultOptimize() {
     return;
   }
 
+  // Recycle the storage of eliminated factors and conditionals between iterations
+  std::unique_ptr<EliminationArena::Scope> arenaScope;
+  if (params.useEliminationArena)
+    arenaScope.reset(new EliminationArena::Scope());
+
   // Iterative loop
   do {
     // Do next iteration
     currentError = error();
     iterate();
     tictoc_finishedIteration();
+    if (arenaScope)
+      EliminationArena::NextIteration();
 
     // Maybe show output
     if (params.verbosity >= NonlinearOptimizerParams::VALUES)
@@ -111,6 +123,18 @@ void NonlinearOptimizer::defaultOptimize() {
   }
 }
 
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr NonlinearOptimizer::linearizeGraph(const Values& values) const {
+  if (!_params().reuseLinearization)
+    return graph_.linearize(values);
+
+  // Start over if a caller still holds on to the previous linear graph
+  if (!linearization_ || !linearization_.unique())
+    linearization_ = boost::make_shared<GaussianFactorGraph>();
+  graph_.linearizeInPlace(values, *linearization_);
+  return linearization_;
+}
+
 /* ************************************************************************* */
 const Values& NonlinearOptimizer::optimizeSafely() {
   static const Values empty;
@@ -132,10 +156,13 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
   // Check which solver we are using
   if (params.isMultifrontal()) {
     // Multifrontal QR or Cholesky (decided by params.getEliminationFunction())
+    // The symbolic structure is reused from the previous iteration if the graph has not changed
     if (params.ordering)
-      delta = gfg.optimize(*params.ordering, params.getEliminationFunction());
+      delta = structureCache_.eliminate(gfg, *params.ordering,
+                                        params.getEliminationFunction())->optimize();
     else
-      delta = gfg.optimize(params.getEliminationFunction());
+      delta = structureCache_.eliminate(gfg, params.orderingType,
+                                        params.getEliminationFunction())->optimize();
   } else if (params.isSequential()) {
     // Sequential QR or Cholesky (decided by params.getEliminationFunction())
     if (params.ordering)
@@ -144,6 +171,21 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
     else
       delta = gfg.eliminateSequential(params.getEliminationFunction(), boost::none,
                                       params.orderingType)->optimize();
+  } else if (params.isCholmod() || params.isMixedPrecision()) {
+    // Supernodal sparse Cholesky, in single precision with iterative refinement
+    // against the double precision graph if mixed precision is requested.
+    // The ordering and symbolic analysis are reused while the graph structure is unchanged.
+    const SupernodalCholesky::Precision precision =
+        params.isMixedPrecision() ? SupernodalCholesky::SINGLE : SupernodalCholesky::DOUBLE;
+    if (!supernodal_ || supernodal_->precision() != precision ||
+        (params.ordering && !(*params.ordering == supernodal_->ordering())) ||
+        !supernodal_->sameStructure(gfg)) {
+      const Ordering ordering = params.ordering ? *params.ordering
+                                                : Ordering::Create(params.orderingType, gfg);
+      supernodal_ = boost::make_shared<SupernodalCholesky>(gfg, ordering, precision);
+    }
+    supernodal_->factorize(gfg);
+    delta = supernodal_->optimize(gfg);
   } else if (params.isIterative()) {
     // Conjugate Gradient -> needs params.iterativeParams
     if (!params.iterativeParams)
@@ -158,7 +200,8 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
                        params.iterativeParams)) {
       if (!params.ordering)
         throw std::runtime_error("SubgraphSolver needs an ordering");
-      delta = SubgraphSolver(gfg, *spcg, *params.ordering).optimize();
+      // The spanning tree is reused from the previous iteration if the graph has not changed
+      delta = SubgraphSolver(gfg, *spcg, *params.ordering, subgraphCache_).optimize();
     } else {
       throw std::runtime_error(
           "NonlinearOptimizer::solve: special cg parameter type is not handled in LM solver ...");
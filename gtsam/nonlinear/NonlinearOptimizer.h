@@ -20,6 +20,9 @@
 
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearOptimizerParams.h>
+#include <gtsam/linear/MultifrontalStructureCache.h>
+#include <gtsam/linear/SubgraphCache.h>
+#include <gtsam/linear/SupernodalCholesky.h>
 
 namespace gtsam {
 
@@ -79,6 +82,19 @@ protected:
 
   std::unique_ptr<internal::NonlinearOptimizerState> state_; ///< PIMPL'd state
 
+  /// Linear graph kept between iterations, see NonlinearOptimizerParams::reuseLinearization
+  mutable GaussianFactorGraph::shared_ptr linearization_;
+
+  /// Symbolic structure of the multifrontal elimination of the previous iteration
+  mutable MultifrontalStructureCache structureCache_;
+
+  /// Spanning tree and subgraph elimination structure of the previous iteration, for SubgraphSolver
+  mutable SubgraphCache subgraphCache_;
+
+  /// Ordering and supernodal structure of the previous iteration, for the CHOLMOD and
+  /// MIXED_PRECISION_CHOLESKY solvers
+  mutable SupernodalCholesky::shared_ptr supernodal_;
+
 public:
   /** A shared pointer to this class */
   typedef boost::shared_ptr<const NonlinearOptimizer> shared_ptr;
@@ -142,6 +158,10 @@ protected:
 
   virtual const NonlinearOptimizerParams& _params() const = 0;
 
+  /** Linearize graph_ at \c values. If NonlinearOptimizerParams::reuseLinearization
+   * is set, the linear factors of the previous call are overwritten in place. */
+  GaussianFactorGraph::shared_ptr linearizeGraph(const Values& values) const;
+
   /** Constructor for initial construction of base classes. Takes ownership of state. */
   NonlinearOptimizer(const NonlinearFactorGraph& graph,
                      std::unique_ptr<internal::NonlinearOptimizerState> state);
@@ -82,6 +82,8 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   std::cout << "         maximum iterations: " << maxIterations << "\n";
   std::cout << "                  verbosity: " << verbosityTranslator(verbosity)
       << "\n";
+  std::cout << "        reuse linearization: " << reuseLinearization << "\n";
+  std::cout << "      use elimination arena: " << useEliminationArena << "\n";
   std::cout.flush();
 
   switch (linearSolverType) {
@@ -100,6 +102,9 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case CHOLMOD:
     std::cout << "         linear solver type: CHOLMOD\n";
     break;
+  case MIXED_PRECISION_CHOLESKY:
+    std::cout << "         linear solver type: MIXED PRECISION CHOLESKY\n";
+    break;
   case Iterative:
     std::cout << "         linear solver type: ITERATIVE\n";
     break;
@@ -139,6 +144,8 @@ std::string NonlinearOptimizerParams::linearSolverTranslator(
     return "ITERATIVE";
   case CHOLMOD:
     return "CHOLMOD";
+  case MIXED_PRECISION_CHOLESKY:
+    return "MIXED_PRECISION_CHOLESKY";
   default:
     throw std::invalid_argument(
         "Unknown linear solver type in SuccessiveLinearizationOptimizer");
@@ -160,6 +167,8 @@ NonlinearOptimizerParams::LinearSolverType NonlinearOptimizerParams::linearSolve
     return Iterative;
   if (linearSolverType == "CHOLMOD")
     return CHOLMOD;
+  if (linearSolverType == "MIXED_PRECISION_CHOLESKY")
+    return MIXED_PRECISION_CHOLESKY;
   throw std::invalid_argument(
       "Unknown linear solver type in SuccessiveLinearizationOptimizer");
 }
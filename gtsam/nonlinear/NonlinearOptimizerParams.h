@@ -44,11 +44,13 @@ public:
   double errorTol; ///< The maximum total error to stop iterating (default 0.0)
   Verbosity verbosity; ///< The printing verbosity during optimization (default SILENT)
   Ordering::OrderingType orderingType; ///< The method of ordering use during variable elimination (default COLAMD)
+  bool reuseLinearization; ///< Overwrite the linear factors of the previous iteration instead of allocating new ones, see NonlinearFactorGraph::linearizeInPlace (default false)
+  bool useEliminationArena; ///< Recycle the matrix storage of eliminated factors and conditionals between iterations, see EliminationArena (default false)
 
   NonlinearOptimizerParams() :
       maxIterations(100), relativeErrorTol(1e-5), absoluteErrorTol(1e-5), errorTol(
           0.0), verbosity(SILENT), orderingType(Ordering::COLAMD),
-          linearSolverType(MULTIFRONTAL_CHOLESKY) {}
+          reuseLinearization(false), useEliminationArena(false), linearSolverType(MULTIFRONTAL_CHOLESKY) {}
 
   virtual ~NonlinearOptimizerParams() {
   }
@@ -58,12 +60,16 @@ public:
   double getRelativeErrorTol() const { return relativeErrorTol; }
   double getAbsoluteErrorTol() const { return absoluteErrorTol; }
   double getErrorTol() const { return errorTol; }
+  bool getReuseLinearization() const { return reuseLinearization; }
+  bool getUseEliminationArena() const { return useEliminationArena; }
   std::string getVerbosity() const { return verbosityTranslator(verbosity); }
 
   void setMaxIterations(int value) { maxIterations = value; }
   void setRelativeErrorTol(double value) { relativeErrorTol = value; }
   void setAbsoluteErrorTol(double value) { absoluteErrorTol = value; }
   void setErrorTol(double value) { errorTol = value; }
+  void setReuseLinearization(bool value) { reuseLinearization = value; }
+  void setUseEliminationArena(bool value) { useEliminationArena = value; }
   void setVerbosity(const std::string& src) {
     verbosity = verbosityTranslator(src);
   }
@@ -78,7 +84,8 @@ public:
     SEQUENTIAL_CHOLESKY,
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
-    CHOLMOD, /* Experimental Flag */
+    CHOLMOD, /* Supernodal sparse Cholesky, see SupernodalCholesky */
+    MIXED_PRECISION_CHOLESKY, /* Single precision supernodal Cholesky with iterative refinement */
   };
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
@@ -99,6 +106,10 @@ public:
     return (linearSolverType == CHOLMOD);
   }
 
+  inline bool isMixedPrecision() const {
+    return (linearSolverType == MIXED_PRECISION_CHOLESKY);
+  }
+
   inline bool isIterative() const {
     return (linearSolverType == Iterative);
   }
@@ -19,6 +19,7 @@
 #include <gtsam/base/Testable.h>
 
 #include <string>
+#include <typeinfo>
 
 namespace gtsam {
 
@@ -90,6 +91,9 @@ namespace gtsam {
 
     /** implement functions needed to derive from Factor */
 
+    /** linearize() is the generic one, but not necessarily in subclasses */
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /** vector of errors */
     Vector evaluateError(const T& x, boost::optional<Matrix&> H = boost::none) const {
       if (H) (*H) = Matrix::Identity(traits<T>::GetDimension(x),traits<T>::GetDimension(x));
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <ostream>
+#include <typeinfo>
 
 #include <gtsam/base/Testable.h>
 #include <gtsam/base/Lie.h>
@@ -86,6 +87,9 @@ namespace gtsam {
 
     /** implement functions needed to derive from Factor */
 
+    /** linearize() is the generic one, but not necessarily in subclasses */
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /** vector of errors */
   Vector evaluateError(const T& p1, const T& p2, boost::optional<Matrix&> H1 =
       boost::none, boost::optional<Matrix&> H2 = boost::none) const {
@@ -137,38 +137,40 @@ public:
     // Only linearize if the factor is active
     if (!this->active(values)) return boost::shared_ptr<JacobianFactor>();
 
-    const Key key1 = this->key1(), key2 = this->key2();
     JacobianC H1;
     JacobianL H2;
     Vector2 b;
-    try {
-      const CAMERA& camera = values.at<CAMERA>(key1);
-      const LANDMARK& point = values.at<LANDMARK>(key2);
-      b = measured() - camera.project2(point, H1, H2);
-    } catch (CheiralityException& e) {
-      H1.setZero();
-      H2.setZero();
-      b.setZero();
-      // TODO warn if verbose output asked for
-    }
-
-    // Whiten the system if needed
-    const SharedNoiseModel& noiseModel = this->noiseModel();
-    if (noiseModel && !noiseModel->isUnit()) {
-      // TODO: implement WhitenSystem for fixed size matrices and include
-      // above
-      H1 = noiseModel->Whiten(H1);
-      H2 = noiseModel->Whiten(H2);
-      b = noiseModel->Whiten(b);
-    }
+    whitenedJacobians(values, H1, H2, b);
 
     // Create new (unit) noiseModel, preserving constraints if applicable
+    const SharedNoiseModel& noiseModel = this->noiseModel();
     SharedDiagonal model;
     if (noiseModel && noiseModel->isConstrained()) {
       model = boost::static_pointer_cast<noiseModel::Constrained>(noiseModel)->unit();
     }
 
-    return boost::make_shared<BinaryJacobianFactor<2, DimC, DimL> >(key1, H1, key2, H2, b, model);
+    return boost::make_shared<BinaryJacobianFactor<2, DimC, DimL> >(this->key1(), H1, this->key2(), H2, b, model);
+  }
+
+  /// Linearize using fixed-size matrices, overwriting a previous linearization if it is not shared
+  void linearizeInPlace(const Values& values,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& /*workspace*/) const {
+    JacobianFactor* jacobian = dynamic_cast<JacobianFactor*>(linearFactor.get());
+    if (!jacobian || !linearFactor.unique() || !this->active(values)
+        || jacobian->keys() != this->keys() || jacobian->rows() != 2) {
+      linearFactor = linearize(values);
+      return;
+    }
+
+    JacobianC H1;
+    JacobianL H2;
+    Vector2 b;
+    whitenedJacobians(values, H1, H2, b);
+    VerticalBlockMatrix& Ab = jacobian->matrixObject();
+    Ab(0) = H1;
+    Ab(1) = H2;
+    Ab(2).col(0) = b;
   }
 
   /** return the measured */
@@ -176,6 +178,34 @@ public:
     return measured_;
   }
 
+protected:
+  /// Compute whitened Jacobians and right-hand side, zero behind the camera
+  void whitenedJacobians(const Values& values, JacobianC& H1, JacobianL& H2, Vector2& b) const {
+    try {
+      const CAMERA& camera = values.at<CAMERA>(this->key1());
+      const LANDMARK& point = values.at<LANDMARK>(this->key2());
+      b = measured() - camera.project2(point, H1, H2);
+    } catch (CheiralityException& e) {
+      H1.setZero();
+      H2.setZero();
+      b.setZero();
+      // TODO warn if verbose output asked for
+    }
+
+    // Whiten the system if needed, [H1 H2 b] together so that robust models
+    // reweight the Jacobians by the residual, as in NoiseModelFactor
+    const SharedNoiseModel& noiseModel = this->noiseModel();
+    if (noiseModel && !noiseModel->isUnit()) {
+      Eigen::Matrix<double, 2, DimC + DimL + 1> Ab;
+      Ab << H1, H2, b;
+      noiseModel::WhitenSystems(*noiseModel, Ab.template leftCols<DimC + DimL>(),
+                                Ab.col(DimC + DimL));
+      H1 = Ab.template leftCols<DimC>();
+      H2 = Ab.template middleCols<DimL>(DimC);
+      b = Ab.col(DimC + DimL);
+    }
+  }
+
 private:
   /** Serialization function */
   friend class boost::serialization::access;
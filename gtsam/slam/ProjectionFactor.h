@@ -24,6 +24,7 @@
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <boost/optional.hpp>
+#include <typeinfo>
 
 namespace gtsam {
 
@@ -127,6 +128,9 @@ namespace gtsam {
           && ((!body_P_sensor_ && !e->body_P_sensor_) || (body_P_sensor_ && e->body_P_sensor_ && body_P_sensor_->equals(*e->body_P_sensor_)));
     }
 
+    /// linearize() is the generic one, but not necessarily in subclasses
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /// Evaluate error h(x)-z and optionally derivatives
     Vector evaluateError(const Pose3& pose, const Point3& point,
         boost::optional<Matrix&> H1 = boost::none, boost::optional<Matrix&> H2 = boost::none) const {
@@ -168,6 +168,13 @@ public:
     return boost::make_shared<JacobianFactor>(this->keys_, Ab);
   }
 
+  /// Linearization is specialized above, so always call linearize()
+  void linearizeInPlace(const Values& x,
+      boost::shared_ptr<GaussianFactor>& linearFactor,
+      LinearizationWorkspace& /*workspace*/) const {
+    linearFactor = linearize(x);
+  }
+
   /** return the measurement */
   const Measurement& measured() const {
     return measured_;
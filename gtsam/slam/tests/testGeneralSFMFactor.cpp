@@ -470,6 +470,16 @@ TEST(GeneralSFMFactor, BinaryJacobianFactor) {
     GaussianFactor::shared_ptr actual = factor.linearize(values);
     EXPECT(assert_equal(*expected, *actual, 1e-9));
 
+    // Test linearizeInPlace, starting from a linearization elsewhere
+    Values other = values;
+    other.update(L(1), Point3(0.1, 0.2, 0.3));
+    GaussianFactor::shared_ptr inPlace = factor.linearize(other);
+    const GaussianFactor* storage = inPlace.get();
+    LinearizationWorkspace workspace;
+    factor.linearizeInPlace(values, inPlace, workspace);
+    EXPECT(storage == inPlace.get());
+    EXPECT(assert_equal(*expected, *inPlace, 1e-9));
+
     // Test methods that rely on updateHessian
     if (model && !model->isConstrained()) {
       // Construct HessianFactor from single JacobianFactor
@@ -495,6 +505,27 @@ TEST(GeneralSFMFactor, BinaryJacobianFactor) {
   }
 }
 
+/* ************************************************************************* */
+TEST(GeneralSFMFactor, RobustLinearize) {
+  // An outlier, so that the Huber loss down-weights the measurement
+  Point2 measurement(3., -1.);
+  Values values;
+  values.insert(X(1), GeneralCamera(Pose3(Rot3(), Point3(0, 0, -6))));
+  values.insert(L(1), Point3(0.1, 0.2, 0.3));
+  SharedNoiseModel model = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(1.0), noiseModel::Isotropic::Sigma(2, 0.5));
+  Projection factor(measurement, model, X(1), L(1));
+
+  // The Jacobians are reweighted by the residual, as in NoiseModelFactor
+  GaussianFactor::shared_ptr expected = factor.NoiseModelFactor::linearize(values);
+  EXPECT(assert_equal(*expected, *factor.linearize(values), 1e-9));
+
+  GaussianFactor::shared_ptr inPlace = factor.linearize(values);
+  LinearizationWorkspace workspace;
+  factor.linearizeInPlace(values, inPlace, workspace);
+  EXPECT(assert_equal(*expected, *inPlace, 1e-9));
+}
+
 /* ************************************************************************* */
 // Do a thorough test of BinaryJacobianFactor
 TEST( GeneralSFMFactor, BinaryJacobianFactor2 ) {
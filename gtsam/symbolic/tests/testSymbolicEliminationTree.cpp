@@ -149,6 +149,39 @@ TEST(EliminationTree, Create2)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(EliminationTree, Eliminate)
+{
+  // Same graph as in Create2, the root X(3) has two independent subtrees
+  SymbolicFactorGraph graph;
+  graph += SymbolicFactor(X(1), L(1));
+  graph += SymbolicFactor(X(1), X(2));
+  graph += SymbolicFactor(X(2), L(1));
+  graph += SymbolicFactor(X(2), X(3));
+  graph += SymbolicFactor(X(3), X(4));
+  graph += SymbolicFactor(X(4), L(2));
+  graph += SymbolicFactor(X(4), X(5));
+  graph += SymbolicFactor(L(2), X(5));
+  graph += SymbolicFactor(X(4), L(3));
+  graph += SymbolicFactor(X(5), L(3));
+
+  Ordering order = list_of(X(1)) (L(3)) (L(1)) (X(5)) (X(2)) (L(2)) (X(4)) (X(3));
+  SymbolicEliminationTree tree(graph, order);
+  LONGS_EQUAL(1, tree.roots().size());
+  EXPECT_LONGS_EQUAL(8, tree.roots()[0]->problemSize());
+  EXPECT_LONGS_EQUAL(3, tree.roots()[0]->children[0]->problemSize());
+
+  // Conditionals come out in depth-first post-order, whether or not the subtrees were
+  // eliminated in parallel
+  const KeyVector expectedOrder = list_of(X(1)) (L(1)) (X(2)) (L(3)) (X(5)) (L(2)) (X(4)) (X(3));
+  auto result = tree.eliminate(EliminateSymbolic);
+  KeyVector actualOrder;
+  for (const auto& conditional : *result.first)
+    actualOrder.push_back(conditional->firstFrontalKey());
+  EXPECT(expectedOrder == actualOrder);
+  EXPECT(result.second->empty());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -57,6 +57,23 @@ TEST( JunctionTree, constructor )
   EXPECT(assert_equal(*simpleChain[1],   *actual.roots().front()->children.front()->factors[1]));
 }
 
+/* ************************************************************************* */
+TEST( JunctionTree, cost )
+{
+  Ordering order; order += 0, 1, 2, 3;
+
+  SymbolicJunctionTree actual(SymbolicEliminationTree(simpleChain, order));
+
+  // Clique 0 1 : 2, and its parent clique 2 3 without separator
+  const SymbolicJunctionTree::sharedNode root = actual.roots().front();
+  const SymbolicJunctionTree::sharedNode child = root->children.front();
+  EXPECT_DOUBLES_EQUAL(EliminationCost(2, 1), child->cost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(8.0 / 3.0 + 4.0 + 2.0, child->cost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(child->cost(), child->subtreeCost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(EliminationCost(2, 0), root->cost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(root->cost() + child->cost(), root->subtreeCost(), 1e-9);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -145,6 +145,9 @@ namespace simulated2D {
 
     virtual ~GenericPrior() {}
 
+    /// Linearized with the generic NoiseModelFactor::linearize
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /// @return a deep copy of this factor
     virtual gtsam::NonlinearFactor::shared_ptr clone() const {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -191,6 +194,9 @@ namespace simulated2D {
 
     virtual ~GenericOdometry() {}
 
+    /// Linearized with the generic NoiseModelFactor::linearize
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /// @return a deep copy of this factor
     virtual gtsam::NonlinearFactor::shared_ptr clone() const {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -238,6 +244,9 @@ namespace simulated2D {
 
     virtual ~GenericMeasurement() {}
 
+    /// Linearized with the generic NoiseModelFactor::linearize
+    virtual bool usesGenericLinearize() const { return typeid(*this) == typeid(This); }
+
     /// @return a deep copy of this factor
     virtual gtsam::NonlinearFactor::shared_ptr clone() const {
       return boost::static_pointer_cast<gtsam::NonlinearFactor>(
@@ -68,6 +68,22 @@ TEST(ExpressionFactor, Leaf) {
   EXPECT_LONGS_EQUAL(2, f.dim());
   boost::shared_ptr<GaussianFactor> gf2 = f.linearize(values);
   EXPECT( assert_equal(*old.linearize(values), *gf2, 1e-9));
+
+  // Re-linearizing in place keeps the factor storage and the noise model
+  Values other;
+  other.insert(2, Point2(1, 2));
+  boost::shared_ptr<GaussianFactor> gf3 = f.linearize(other);
+  const GaussianFactor* storage = gf3.get();
+  LinearizationWorkspace workspace;
+  f.linearizeInPlace(values, gf3, workspace);
+  EXPECT(storage == gf3.get());
+  EXPECT( assert_equal(*gf2, *gf3, 1e-9));
+
+  boost::shared_ptr<GaussianFactor> gf4 = old.linearize(other);
+  storage = gf4.get();
+  old.linearizeInPlace(values, gf4, workspace);
+  EXPECT(storage == gf4.get());
+  EXPECT( assert_equal(*gf2, *gf4, 1e-9));
 }
 
 /* ************************************************************************* */
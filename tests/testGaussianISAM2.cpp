@@ -8,16 +8,19 @@
 
 #include <tests/smallExample.h>
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/nonlinear/PriorFactor.h>
 #include <gtsam/sam/BearingRangeFactor.h>
 #include <gtsam/geometry/Point2.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Marginals.h>
+#include <gtsam/nonlinear/ISAM2Marginals.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/TaskGroup.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/treeTraversal-inst.h>
@@ -26,6 +29,11 @@
 
 #include <boost/assign/list_of.hpp>
 #include <boost/range/adaptor/map.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
 using namespace boost::assign;
 namespace br { using namespace boost::adaptors; using namespace boost::range; }
 
@@ -345,6 +353,85 @@ TEST(ISAM2, slamlike_solution_dogleg_qr)
   CHECK(isam_check(fullgraph, fullinit, isam, *this, result_));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, slamlike_solution_parallel)
+{
+  // Relinearize all factors in every update, serially and with parallel tasks
+  const ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 1, true);
+  const auto create = [&params](size_t nrThreads) {
+    ConcurrencyScope scope(nrThreads);
+    return createSlamlikeISAM2(boost::none, boost::none, params);
+  };
+  ISAM2 serial = create(1);
+  ISAM2 parallel = create(4);
+
+  // Compare solutions
+  EXPECT(assert_equal(serial.getLinearizationPoint(), parallel.getLinearizationPoint()));
+  EXPECT(assert_equal(serial.getDelta(), parallel.getDelta()));
+  EXPECT(assert_equal(serial.calculateEstimate(), parallel.calculateEstimate()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, optimizeWildfireParallel)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+
+  // Back-substitute from a zero delta, with only the root variables replaced
+  KeySet replaced;
+  for (const ISAM2::sharedClique& root : isam.roots())
+    replaced.insert(root->conditional()->beginFrontals(),
+                    root->conditional()->endFrontals());
+  VectorValues expected = VectorValues::Zero(isam.getDelta());
+  VectorValues actual = expected;
+  size_t expectedCount = 0, actualCount = 0;
+  for (const ISAM2::sharedClique& root : isam.roots())
+    expectedCount +=
+        optimizeWildfireNonRecursive(root, 0.001, replaced, &expected);
+
+  {
+    ConcurrencyScope scope(4);
+    for (const ISAM2::sharedClique& root : isam.roots())
+      actualCount += optimizeWildfireParallel(root, 0.001, replaced, &actual);
+  }
+
+  EXPECT(assert_equal(expected, actual, 0.0));
+  EXPECT(expectedCount > 0);
+  EXPECT_LONGS_EQUAL(expectedCount, actualCount);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, publishEstimates)
+{
+  EXPECT(!createSlamlikeISAM2().estimateSnapshot());
+
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 1, true);
+  params.publishEstimates = true;
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph, params);
+  const boost::shared_ptr<const Values> snapshot = isam.estimateSnapshot();
+  CHECK(snapshot);
+  EXPECT(assert_equal(isam.calculateEstimate(), *snapshot));
+  const Values expectedSnapshot = *snapshot;
+
+  // Remove the measurements on landmark 100, which removes the variable, while
+  // holding on to the snapshot
+  isam.update(NonlinearFactorGraph(), Values(), FactorIndices{7, 14});
+  EXPECT(assert_equal(expectedSnapshot, *snapshot, 1e-15));
+  EXPECT(!isam.estimateSnapshot()->exists(100));
+  EXPECT(assert_equal(isam.calculateEstimate(), *isam.estimateSnapshot()));
+
+  // Relinearize all variables in a few updates that each reuse a buffer
+  for (size_t i = 0; i < 3; ++i) {
+    ISAM2UpdateParams updateParams;
+    updateParams.force_relinearize = true;
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(0, 11, Pose2(11.0, 0.0, 0.0), odoNoise);
+    isam.update(newfactors, Values(), updateParams);
+    EXPECT(assert_equal(isam.calculateEstimate(), *isam.estimateSnapshot()));
+  }
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, clone) {
 
@@ -795,6 +882,41 @@ TEST(ISAM2, marginalizeLeaves5)
   EXPECT(checkMarginalizeLeaves(isam, marginalizeKeys));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, marginalizeLeavesIndices)
+{
+  ISAM2Params params;
+  params.findUnusedFactorSlots = true;
+  ISAM2 isam(params);
+
+  NonlinearFactorGraph factors;
+  factors.addPrior(0, 0.0, model);
+  factors += BetweenFactor<double>(0, 1, 0.0, model);
+  factors += BetweenFactor<double>(1, 2, 0.0, model);
+  Values values;
+  values.insert(0, 0.0);
+  values.insert(1, 0.0);
+  values.insert(2, 0.0);
+  FastMap<Key, int> constrainedKeys;
+  constrainedKeys.insert(make_pair(0, 0));
+  constrainedKeys.insert(make_pair(1, 1));
+  constrainedKeys.insert(make_pair(2, 2));
+  isam.update(factors, values, FactorIndices(), constrainedKeys);
+
+  // The marginal factors never take the slots of the removed factors
+  FastList<Key> leafKeys = list_of(0);
+  FactorIndices marginalFactorsIndices, deletedFactorsIndices;
+  isam.marginalizeLeaves(leafKeys, marginalFactorsIndices,
+                         deletedFactorsIndices);
+  EXPECT(!marginalFactorsIndices.empty());
+  EXPECT(!deletedFactorsIndices.empty());
+  for (const FactorIndex index : marginalFactorsIndices) {
+    EXPECT(std::find(deletedFactorsIndices.begin(), deletedFactorsIndices.end(),
+                     index) == deletedFactorsIndices.end());
+    EXPECT(isam.getFactorsUnsafe()[index]);
+  }
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, marginalCovariance)
 {
@@ -807,6 +929,381 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, ISAM2Marginals)
+{
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  ISAM2 isam = createSlamlikeISAM2(fullinit, fullgraph);
+  ISAM2Marginals marginals(isam);
+
+  for (size_t i = 0; i < 2; ++i) {
+    const Marginals expected(GaussianFactorGraph(isam), isam.getDelta());
+
+    // Single variables, twice to use the cached covariances
+    for (size_t k = 0; k < 2; ++k) {
+      for (Key key : isam.getLinearizationPoint().keys())
+        EXPECT(assert_equal(expected.marginalCovariance(key),
+                            marginals.marginalCovariance(key), 1e-8));
+    }
+    const FastMap<Key, Matrix> covariances =
+        marginals.marginalCovariances(KeyVector{100, 101, 3});
+    EXPECT_LONGS_EQUAL(3, covariances.size());
+    EXPECT(assert_equal(expected.marginalCovariance(101), covariances.at(101),
+                        1e-8));
+
+    // Joint marginals, within a clique and over several cliques
+    const KeyVector clique(isam.clique(0)->conditional()->begin(),
+                           isam.clique(0)->conditional()->end());
+    for (const KeyVector& keys : {clique, KeyVector{0, 5, 100}}) {
+      EXPECT(assert_equal(expected.jointMarginalCovariance(keys).fullMatrix(),
+                          marginals.jointMarginalCovariance(keys).fullMatrix(),
+                          1e-8));
+    }
+
+    // Add a loop closure, which changes all covariances
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(0, 11, Pose2(11.0, 0.0, 0.0), odoNoise);
+    isam.update(newfactors, Values());
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, ISAM2MarginalsRefresh)
+{
+  ISAM2 isam = createSlamlikeISAM2();
+  ISAM2Marginals marginals(isam);
+  for (Key key : isam.getLinearizationPoint().keys())
+    marginals.marginalCovariance(key);
+  std::set<ISAM2::sharedClique> cliques;
+  for (const auto& key_clique : isam.nodes()) cliques.insert(key_clique.second);
+  EXPECT_LONGS_EQUAL(cliques.size(), marginals.nrCachedCliques());
+
+  // The data of the re-eliminated cliques is dropped at the next query, and
+  // only the root is computed again
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 11, Pose2(11.0, 0.0, 0.0), odoNoise);
+  isam.update(newfactors, Values());
+  const Key root = isam.roots().front()->conditional()->front();
+  marginals.marginalCovariance(root);
+  EXPECT(marginals.nrCachedCliques() < cliques.size());
+  const Marginals expected(GaussianFactorGraph(isam), isam.getDelta());
+  EXPECT(assert_equal(expected.marginalCovariance(root),
+                      marginals.marginalCovariance(root), 1e-8));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, maxRelinearizedVariables)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 10, true);
+  params.enableDetailedResults = true;
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // A loop closure that is off, so that many variables move
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 11, Pose2(10.5, 0.5, 0.1), odoNoise);
+  isam.update(newfactors, Values());
+
+  // Relinearize at most two variables
+  ISAM2UpdateParams updateParams;
+  updateParams.force_relinearize = true;
+  updateParams.maxRelinearizedVariables = 2;
+  ISAM2Result result = isam.update(NonlinearFactorGraph(), Values(),
+                                   updateParams);
+  EXPECT(!result.deferredRelinKeys.empty());
+  size_t nrRelinearized = 0;
+  for (const auto& key_status : result.details()->variableStatus) {
+    if (key_status.second.isAboveRelinThreshold) {
+      ++nrRelinearized;
+      EXPECT(!result.deferredRelinKeys.count(key_status.first));
+    }
+  }
+  EXPECT_LONGS_EQUAL(2, nrRelinearized);
+
+  // The deferred variables are relinearized in the next update, although
+  // relinearization would be skipped
+  const KeySet deferred = result.deferredRelinKeys;
+  result = isam.update();
+  EXPECT(result.deferredRelinKeys.empty());
+  for (Key key : deferred)
+    EXPECT(result.details()->variableStatus[key].isAboveRelinThreshold);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, variablesAboveRelinThreshold)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 10, true);
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // A loop closure that is off, so that many variables move
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(0, 11, Pose2(10.5, 0.5, 0.1), odoNoise);
+  ISAM2Result result = isam.update(newfactors, Values());
+  EXPECT_LONGS_EQUAL(0, result.variablesAboveRelinThreshold);
+
+  // The count includes the variables deferred by the budget
+  size_t expected = 0;
+  for (const auto& key_delta : isam.getDelta())
+    if (key_delta.second.lpNorm<Eigen::Infinity>() >= 0.01) ++expected;
+  CHECK(expected > 2);
+  ISAM2UpdateParams updateParams;
+  updateParams.force_relinearize = true;
+  updateParams.maxRelinearizedVariables = 2;
+  result = isam.update(NonlinearFactorGraph(), Values(), updateParams);
+  EXPECT_LONGS_EQUAL(expected, result.variablesAboveRelinThreshold);
+  EXPECT_LONGS_EQUAL(expected - 2, result.deferredRelinKeys.size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, backgroundRelinearization)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 1, true);
+  ISAM2 synchronous(params);
+  params.backgroundRelinearization = true;
+  ISAM2 background(params);
+
+  // A chain of poses with poor initial estimates, and a loop closure
+  NonlinearFactorGraph chain;
+  Values init;
+  chain.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert(0, Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 6; ++i) {
+    chain += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    init.insert(i, Pose2(i + 0.2, 0.3, -0.1));
+  }
+  NonlinearFactorGraph loopClosure;
+  loopClosure += BetweenFactor<Pose2>(0, 5, Pose2(5.0, 0.0, 0.0), odoNoise);
+  for (ISAM2* isam : {&synchronous, &background}) {
+    isam->update(chain, init);
+    isam->update(loopClosure, Values());
+  }
+
+  // The loop closure update relinearized synchronously, but only started the
+  // relinearization in the background
+  EXPECT(!synchronous.relinearizationPending());
+  EXPECT(background.relinearizationPending());
+  EXPECT(assert_equal(init, background.getLinearizationPoint(), 1e-15));
+
+  // Wait for the relinearization and swap it in, including the relinearization
+  // of the loop closure that was added in the meantime
+  ISAM2UpdateParams updateParams;
+  updateParams.force_relinearize = true;
+  const ISAM2Result result =
+      background.update(NonlinearFactorGraph(), Values(), updateParams);
+  EXPECT(!background.relinearizationPending());
+  EXPECT_LONGS_EQUAL(6, result.variablesRelinearized);
+  EXPECT(assert_equal(synchronous.getLinearizationPoint(),
+                      background.getLinearizationPoint()));
+  EXPECT(assert_equal(synchronous.calculateEstimate(),
+                      background.calculateEstimate(), 1e-8));
+}
+
+/* ************************************************************************* */
+namespace {
+// A prior that cannot be linearized once its variable is close to the origin,
+// like a projection factor whose landmark moved behind the camera
+class ThrowingPrior : public PriorFactor<Pose2> {
+ public:
+  ThrowingPrior(Key key, const Pose2& prior, const SharedNoiseModel& model)
+      : PriorFactor<Pose2>(key, prior, model) {}
+  virtual NonlinearFactor::shared_ptr clone() const {
+    return boost::make_shared<ThrowingPrior>(*this);
+  }
+  virtual Vector evaluateError(const Pose2& x,
+                               boost::optional<Matrix&> H = boost::none) const {
+    if (H && x.x() < 0.05) throw std::runtime_error("ThrowingPrior");
+    return PriorFactor<Pose2>::evaluateError(x, H);
+  }
+};
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, backgroundRelinearizationFailure)
+{
+  ConcurrencyScope scope(2);
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 1, true);
+  params.backgroundRelinearization = true;
+  ISAM2 isam(params);
+
+  // The prior throws once x0 is relinearized close to its measurement
+  NonlinearFactorGraph chain;
+  Values init;
+  chain += ThrowingPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert(0, Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 6; ++i) {
+    chain += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    init.insert(i, Pose2(i + 0.2, 0.3, -0.1));
+  }
+  isam.update(chain, init);
+  isam.update();
+  CHECK(isam.relinearizationPending());
+
+  // An update that does not wait for the relinearization still rethrows
+  bool thrown = false;
+  for (size_t i = 0; i < 1000 && !thrown; ++i) {
+    try {
+      isam.update();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+  }
+  EXPECT(thrown);
+  EXPECT(!isam.relinearizationPending());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, batchReordering)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.1, 10, true);
+  params.evaluateFillStatistics = true;
+  ISAM2 incremental(params);
+  params.batchReorderInterval = 1;
+  ISAM2 reordered(params);
+
+  // The same updates, until the first batch reordering
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  createSlamlikeISAM2(fullinit, fullgraph);
+  ISAM2Result result;
+  for (ISAM2* isam : {&incremental, &reordered})
+    result = isam->update(fullgraph, fullinit);
+  EXPECT(!result.batchReordered);
+  for (size_t i = 0; i < 1000 && !result.batchReordered; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    result = reordered.update();
+  }
+  EXPECT(result.batchReordered);
+  EXPECT_LONGS_EQUAL(fullinit.size(), result.variablesReeliminated);
+  EXPECT(assert_equal(incremental.calculateBestEstimate(),
+                      reordered.calculateBestEstimate(), 1e-6));
+
+  // Fill statistics of the reordered tree
+  CHECK(result.fill);
+  size_t nnz = 0, maxCliqueSize = 0;
+  for (const auto& root : reordered.roots()) nnz += root->calculate_nnz();
+  for (const auto& key_clique : reordered.nodes())
+    maxCliqueSize =
+        std::max(maxCliqueSize, key_clique.second->conditional()->size());
+  EXPECT_LONGS_EQUAL(nnz, result.fill->nnz);
+  EXPECT_LONGS_EQUAL(maxCliqueSize, result.fill->maxCliqueSize);
+  EXPECT(result.fill->meanCliqueSize > 0.0);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, batchReorderingObservedLast)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.1, 10, true);
+  params.batchReorderInterval = 1;
+  ISAM2 isam(params);
+
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  createSlamlikeISAM2(fullinit, fullgraph);
+  isam.update(fullgraph, fullinit);
+
+  // Observe the first two poses again until an update uses the batch ordering
+  NonlinearFactorGraph observation;
+  observation += BetweenFactor<Pose2>(0, 1, Pose2(1.0, 0.0, 0.0),
+                                      noiseModel::Isotropic::Sigma(3, 0.1));
+  ISAM2Result result;
+  for (size_t i = 0; i < 1000 && !result.batchReordered; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    result = isam.update(observation);
+  }
+  CHECK(result.batchReordered);
+
+  // The observed variables are eliminated last, i.e., they are in a root
+  EXPECT(!isam[0]->parent());
+  EXPECT(!isam[1]->parent());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, batchReorderingFailure)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.1, 10, true);
+  params.batchReorderInterval = 1;
+  params.batchReorderingType = Ordering::CUSTOM;  // Ordering::Create throws
+  ISAM2 isam(params);
+
+  Values fullinit;
+  NonlinearFactorGraph fullgraph;
+  createSlamlikeISAM2(fullinit, fullgraph);
+  isam.update(fullgraph, fullinit);
+
+  // The update that finds the failed ordering throws before changing anything
+  bool thrown = false;
+  Values before;
+  for (size_t i = 0; i < 1000 && !thrown; ++i) {
+    before = isam.getLinearizationPoint();
+    try {
+      isam.update();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+  }
+  CHECK(thrown);
+  EXPECT(assert_equal(before, isam.getLinearizationPoint()));
+
+  // The failed job was dropped, so the next update starts a new one
+  thrown = false;
+  try {
+    isam.update();
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  EXPECT(!thrown);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, marginalizationLag)
+{
+  const int lag = 3;
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 1);
+  params.findUnusedFactorSlots = true;
+  params.marginalizationLag = lag;
+  ISAM2 isam(params);
+
+  // A chain of poses, one per update, with odometry to the previous two poses
+  NonlinearFactorGraph prior;
+  prior.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  Values init;
+  init.insert(0, Pose2(0.01, 0.01, 0.01));
+  ISAM2Result result = isam.update(prior, init);
+  EXPECT(result.marginalizedKeys.empty());
+
+  size_t maxFactors = 0;
+  for (size_t i = 1; i < 30; ++i) {
+    NonlinearFactorGraph odometry;
+    odometry += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    if (i >= 2)
+      odometry +=
+          BetweenFactor<Pose2>(i - 2, i, Pose2(2.0, 0.0, 0.0), odoNoise);
+    Values newPose;
+    newPose.insert(i, Pose2(i + 0.01, 0.01, 0.01));
+    result = isam.update(odometry, newPose);
+
+    // The pose added lag updates ago leaves the window
+    if (i >= size_t(lag)) {
+      EXPECT(assert_container_equality(KeyVector{i - lag},
+                                       result.marginalizedKeys));
+    } else {
+      EXPECT(result.marginalizedKeys.empty());
+    }
+    EXPECT_LONGS_EQUAL(std::min<size_t>(i + 1, lag),
+                       isam.getLinearizationPoint().size());
+    EXPECT_LONGS_EQUAL(isam.getLinearizationPoint().size(),
+                       isam.getDelta().size());
+    maxFactors = std::max(maxFactors, isam.getFactorsUnsafe().size());
+  }
+
+  // The factor storage stays bounded, and the estimate is still consistent
+  EXPECT(maxFactors < 10);
+  EXPECT(assert_equal(Pose2(29.0, 0.0, 0.0),
+                      isam.calculateEstimate<Pose2>(29), 1e-4));
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
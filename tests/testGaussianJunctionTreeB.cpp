@@ -272,6 +272,28 @@ TEST( GaussianJunctionTreeB, constructor2 ) {
 //  EXPECT(assert_equal(expected, actual3));
 //}
 
+/* ************************************************************************* */
+TEST( GaussianJunctionTreeB, cost ) {
+  // Two 6-dimensional poses that both see a 2-dimensional point
+  GaussianFactorGraph gfg;
+  gfg.add(X(1), Matrix::Identity(6, 6), Vector::Zero(6));
+  gfg.add(X(1), Matrix::Ones(2, 6), L(1), I_2x2, Vector2::Zero());
+  gfg.add(X(2), Matrix::Ones(2, 6), L(1), I_2x2, Vector2::Zero());
+  Ordering ordering;
+  ordering += X(1), X(2), L(1);
+
+  GaussianJunctionTree actual(GaussianEliminationTree(gfg, ordering));
+
+  // One pose is merged with the point in the root clique, the other one is eliminated in a
+  // child clique with the point as separator
+  const GaussianJunctionTree::sharedNode root = actual.roots().front();
+  LONGS_EQUAL(1, root->children.size());
+  const GaussianJunctionTree::sharedNode child = root->children.front();
+  EXPECT_DOUBLES_EQUAL(EliminationCost(6, 2), child->cost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(EliminationCost(8, 0), root->cost(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(root->cost() + child->cost(), root->subtreeCost(), 1e-9);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
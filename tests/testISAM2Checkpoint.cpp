@@ -0,0 +1,171 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testISAM2Checkpoint.cpp
+ * @brief Unit tests for ISAM2 checkpoints
+ * @date Oct 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/serialization.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Types written by ISAM2::saveCheckpoint with a boost archive
+GTSAM_VALUE_EXPORT(gtsam::Pose2);
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::PriorFactor<gtsam::Pose2>, "gtsam::PriorFactorPose2");
+BOOST_CLASS_EXPORT_GUID(gtsam::BetweenFactor<gtsam::Pose2>, "gtsam::BetweenFactorPose2");
+
+static const SharedDiagonal odoNoise = noiseModel::Diagonal::Sigmas(
+    (Vector(3) << 0.1, 0.1, M_PI / 100.0).finished());
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, saveAndLoad) {
+  // A chain of poses with a loop closure
+  NonlinearFactorGraph chain;
+  Values init;
+  chain.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert(0, Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 8; ++i) {
+    chain += BetweenFactor<Pose2>(i - 1, i, Pose2(1.0, 0.0, 0.0), odoNoise);
+    init.insert(i, Pose2(i + 0.2, 0.3, -0.1));
+  }
+  NonlinearFactorGraph loopClosure;
+  loopClosure += BetweenFactor<Pose2>(2, 7, Pose2(5.0, 0.0, 0.0), odoNoise);
+
+  // Cliques cache Hessian factors with Cholesky, and Jacobian factors with QR
+  for (const auto factorization : {ISAM2Params::CHOLESKY, ISAM2Params::QR}) {
+    ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 1);
+    params.factorization = factorization;
+    ISAM2 isam(params);
+    isam.update(chain, init);
+    isam.update(loopClosure, Values());
+
+    stringstream checkpoint;
+    isam.saveCheckpoint(checkpoint);
+    ISAM2 restarted(params);
+    restarted.loadCheckpoint(checkpoint);
+    EXPECT(assert_equal(isam, restarted));
+    EXPECT(assert_equal(isam.getDelta(), restarted.getDelta()));
+    EXPECT(isam.getVariableIndex().equals(restarted.getVariableIndex()));
+
+    // Both continue in the same way
+    NonlinearFactorGraph odometry;
+    odometry += BetweenFactor<Pose2>(7, 8, Pose2(1.0, 0.0, 0.0), odoNoise);
+    Values newPose;
+    newPose.insert(8, Pose2(8.1, 0.2, 0.0));
+    isam.update(odometry, newPose);
+    restarted.update(odometry, newPose);
+    EXPECT(assert_equal(isam.calculateEstimate(),
+                        restarted.calculateEstimate(), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, invalid) {
+  stringstream garbage("not a checkpoint");
+  ISAM2 isam;
+  CHECK_EXCEPTION(isam.loadCheckpoint(garbage), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, corrupt) {
+  NonlinearFactorGraph graph;
+  Values init;
+  graph.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert(0, Pose2(0.1, -0.1, 0.05));
+  ISAM2 isam;
+  isam.update(graph, init);
+  stringstream checkpoint;
+  isam.saveCheckpoint(checkpoint);
+  const string valid = checkpoint.str();
+
+  // The header is the magic, the version and the byte order marker
+  const size_t byteOrderOffset = 8 + sizeof(uint32_t);
+  string swapped = valid;
+  std::reverse(swapped.begin() + byteOrderOffset,
+               swapped.begin() + byteOrderOffset + sizeof(uint32_t));
+  stringstream otherByteOrder(swapped);
+  ISAM2 loaded;
+  CHECK_EXCEPTION(loaded.loadCheckpoint(otherByteOrder), std::invalid_argument);
+
+  // A huge size, here of the first archive after the update count and the
+  // dogleg delta, is rejected before it is allocated
+  const size_t sizeOffset = byteOrderOffset + sizeof(uint32_t) +
+                            sizeof(int64_t) + sizeof(uint8_t) + sizeof(double);
+  string huge = valid;
+  const uint64_t hugeSize = uint64_t(1) << 60;
+  huge.replace(sizeOffset, sizeof(uint64_t),
+               reinterpret_cast<const char*>(&hugeSize), sizeof(uint64_t));
+  stringstream corruptSize(huge);
+  CHECK_EXCEPTION(loaded.loadCheckpoint(corruptSize), std::invalid_argument);
+
+  // Truncated checkpoints are rejected as well
+  stringstream truncated(valid.substr(0, valid.size() / 2));
+  CHECK_EXCEPTION(loaded.loadCheckpoint(truncated), std::invalid_argument);
+
+  // So is a corrupt archive, here its signature after the archive size
+  string badArchive = valid;
+  badArchive[sizeOffset + sizeof(uint64_t) + 12] ^= 0x55;
+  stringstream corruptArchive(badArchive);
+  CHECK_EXCEPTION(loaded.loadCheckpoint(corruptArchive), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2Checkpoint, unchangedOnFailure) {
+  NonlinearFactorGraph graph;
+  Values init;
+  graph.addPrior(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+  init.insert(0, Pose2(0.1, -0.1, 0.05));
+  graph += BetweenFactor<Pose2>(0, 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+  init.insert(1, Pose2(1.2, 0.3, -0.1));
+  ISAM2 isam;
+  isam.update(graph, init);
+  stringstream checkpoint;
+  isam.saveCheckpoint(checkpoint);
+  const string valid = checkpoint.str();
+
+  // A different state, which a checkpoint cut anywhere does not touch
+  ISAM2 other;
+  NonlinearFactorGraph prior;
+  Values initOther;
+  prior.addPrior(5, Pose2(2.0, 1.0, 0.5), odoNoise);
+  initOther.insert(5, Pose2(2.1, 0.9, 0.4));
+  other.update(prior, initOther);
+  const ISAM2 expected = other;
+  for (size_t k = 1; k < 16; ++k) {
+    stringstream truncated(valid.substr(0, valid.size() * k / 16));
+    CHECK_EXCEPTION(other.loadCheckpoint(truncated), std::invalid_argument);
+    EXPECT(assert_equal(expected, other));
+    EXPECT(assert_equal(expected.getLinearizationPoint(),
+                        other.getLinearizationPoint()));
+    EXPECT(assert_equal(expected.getDelta(), other.getDelta()));
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -386,6 +386,49 @@ TEST(NonlinearFactor, NoiseModelFactor6) {
 
 }
 
+/* ************************************************************************* */
+// A measurement with its own linearize(), which doubles the right-hand side
+class DoubledMeasurement : public simulated2D::Measurement {
+ public:
+  DoubledMeasurement(const Point2& measured, const SharedNoiseModel& model,
+                     Key i, Key j)
+      : simulated2D::Measurement(measured, model, i, j) {}
+  virtual GaussianFactor::shared_ptr linearize(const Values& x) const {
+    JacobianFactor::shared_ptr jacobian =
+        boost::dynamic_pointer_cast<JacobianFactor>(
+            simulated2D::Measurement::linearize(x));
+    jacobian->getb() *= 2.0;
+    return jacobian;
+  }
+};
+
+TEST( NonlinearFactor, linearizeInPlace )
+{
+  SharedNoiseModel sigma(noiseModel::Isotropic::Sigma(2, 0.2));
+  Values values, other;
+  values.insert(X(1), Point2(0., 0.));
+  values.insert(L(1), Point2(0.5, -0.5));
+  other.insert(X(1), Point2(0.1, 0.2));
+  other.insert(L(1), Point2(0.3, 0.1));
+  LinearizationWorkspace workspace;
+
+  // A class that uses the generic linearize() is overwritten in place
+  simulated2D::Measurement plain(Point2(0., -1.), sigma, X(1), L(1));
+  EXPECT(plain.usesGenericLinearize());
+  GaussianFactor::shared_ptr linear = plain.linearize(values);
+  const GaussianFactor* storage = linear.get();
+  plain.linearizeInPlace(other, linear, workspace);
+  EXPECT(storage == linear.get());
+  EXPECT(assert_equal(*plain.linearize(other), *linear));
+
+  // Its subclasses do not inherit that, so their own linearize() is used
+  DoubledMeasurement doubled(Point2(0., -1.), sigma, X(1), L(1));
+  EXPECT(!doubled.usesGenericLinearize());
+  linear = doubled.linearize(values);
+  doubled.linearizeInPlace(other, linear, workspace);
+  EXPECT(assert_equal(*doubled.linearize(other), *linear));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactor, clone_rekey )
 {
@@ -116,6 +116,29 @@ TEST( NonlinearFactorGraph, linearize )
   CHECK(assert_equal(expected,linearFG)); // Needs correct linearizations
 }
 
+/* ************************************************************************* */
+TEST( NonlinearFactorGraph, linearizeInPlace )
+{
+  NonlinearFactorGraph fg = createNonlinearFactorGraph();
+  GaussianFactorGraph linearFG;
+  fg.linearizeInPlace(createNoisyValues(), linearFG);
+  EXPECT(assert_equal(createGaussianFactorGraph(), linearFG));
+
+  // Linearizing at another point overwrites the same factors
+  const Values values = createValues();
+  const GaussianFactor* first = linearFG[0].get();
+  fg.linearizeInPlace(values, linearFG);
+  EXPECT(first == linearFG[0].get());
+  EXPECT(assert_equal(*fg.linearize(values), linearFG));
+
+  // Factors that are shared elsewhere are left alone
+  const GaussianFactor::shared_ptr shared = linearFG[0];
+  fg.linearizeInPlace(createNoisyValues(), linearFG);
+  EXPECT(shared != linearFG[0]);
+  EXPECT(assert_equal(*fg.linearize(values)->at(0), *shared));
+  EXPECT(assert_equal(createGaussianFactorGraph(), linearFG));
+}
+
 /* ************************************************************************* */
 TEST( NonlinearFactorGraph, clone )
 {
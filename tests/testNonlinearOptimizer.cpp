@@ -28,6 +28,7 @@
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/EliminationArena.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -159,6 +160,10 @@ TEST( NonlinearOptimizer, optimization_method )
   paramsQR.linearSolverType = LevenbergMarquardtParams::MULTIFRONTAL_QR;
   LevenbergMarquardtParams paramsChol;
   paramsChol.linearSolverType = LevenbergMarquardtParams::MULTIFRONTAL_CHOLESKY;
+  LevenbergMarquardtParams paramsSupernodal;
+  paramsSupernodal.linearSolverType = LevenbergMarquardtParams::CHOLMOD;
+  LevenbergMarquardtParams paramsMixed;
+  paramsMixed.linearSolverType = LevenbergMarquardtParams::MIXED_PRECISION_CHOLESKY;
 
   NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
 
@@ -171,6 +176,99 @@ TEST( NonlinearOptimizer, optimization_method )
 
   Values actualMFChol = LevenbergMarquardtOptimizer(fg, c0, paramsChol).optimize();
   DOUBLES_EQUAL(0,fg.error(actualMFChol),tol);
+
+  Values actualSupernodal = LevenbergMarquardtOptimizer(fg, c0, paramsSupernodal).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualSupernodal),tol);
+
+  Values actualMixed = LevenbergMarquardtOptimizer(fg, c0, paramsMixed).optimize();
+  DOUBLES_EQUAL(0,fg.error(actualMixed),tol);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, SupernodalIterations )
+{
+  // A loop of poses, optimized over several iterations that reuse the supernodal structure
+  NonlinearFactorGraph graph;
+  graph.addPrior(X(1), Pose2(0., 0., 0.), noiseModel::Isotropic::Sigma(3, 0.1));
+  Values initial;
+  Pose2 pose(0.1, -0.1, 0.05);
+  initial.insert(X(1), pose);
+  for (size_t i = 1; i < 8; ++i) {
+    graph += BetweenFactor<Pose2>(X(i), X(i + 1), Pose2(1., 0., M_PI_4),
+                                  noiseModel::Isotropic::Sigma(3, 0.2));
+    pose = pose.compose(Pose2(1.1, 0.1, M_PI_4 - 0.05));
+    initial.insert(X(i + 1), pose);
+  }
+  graph += BetweenFactor<Pose2>(X(8), X(1), Pose2(1., 0., M_PI_4),
+                                noiseModel::Isotropic::Sigma(3, 0.2));
+
+  LevenbergMarquardtParams params;
+  const Values expected = LevenbergMarquardtOptimizer(graph, initial, params).optimize();
+  LevenbergMarquardtParams supernodal;
+  supernodal.linearSolverType = LevenbergMarquardtParams::CHOLMOD;
+  EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(graph, initial, supernodal).optimize(),
+                      1e-6));
+  LevenbergMarquardtParams mixed;
+  mixed.linearSolverType = LevenbergMarquardtParams::MIXED_PRECISION_CHOLESKY;
+  EXPECT(assert_equal(expected, LevenbergMarquardtOptimizer(graph, initial, mixed).optimize(),
+                      1e-6));
+
+  GaussNewtonParams gnParams;
+  gnParams.linearSolverType = GaussNewtonParams::CHOLMOD;
+  gnParams.ordering = Ordering::Colamd(graph);
+  GaussNewtonOptimizer gn(graph, initial, gnParams);
+  EXPECT(assert_equal(expected, gn.optimize(), 1e-6));
+  EXPECT(gn.iterations() > 1);
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, ReuseLinearization )
+{
+  NonlinearFactorGraph graph;
+  graph.addPrior(X(1), Pose2(0., 0., 0.), noiseModel::Isotropic::Sigma(3, 0.1));
+  Values initial;
+  initial.insert(X(1), Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 5; ++i) {
+    graph += BetweenFactor<Pose2>(X(i), X(i + 1), Pose2(1., 0., M_PI_2),
+                                  noiseModel::Isotropic::Sigma(3, 0.2));
+    initial.insert(X(i + 1), Pose2(i + 0.2, 0.1 * i, 0.3 * i));
+  }
+
+  // Overwriting the linear factors between iterations gives the same result
+  LevenbergMarquardtParams params;
+  LevenbergMarquardtParams reuse;
+  reuse.setReuseLinearization(true);
+  EXPECT(assert_equal(LevenbergMarquardtOptimizer(graph, initial, params).optimize(),
+                      LevenbergMarquardtOptimizer(graph, initial, reuse).optimize()));
+
+  GaussNewtonParams gnParams;
+  GaussNewtonParams gnReuse;
+  gnReuse.setReuseLinearization(true);
+  EXPECT(assert_equal(GaussNewtonOptimizer(graph, initial, gnParams).optimize(),
+                      GaussNewtonOptimizer(graph, initial, gnReuse).optimize()));
+}
+
+/* ************************************************************************* */
+TEST( NonlinearOptimizer, UseEliminationArena )
+{
+  NonlinearFactorGraph graph;
+  graph.addPrior(X(1), Pose2(0., 0., 0.), noiseModel::Isotropic::Sigma(3, 0.1));
+  Values initial;
+  initial.insert(X(1), Pose2(0.1, -0.1, 0.05));
+  for (size_t i = 1; i < 5; ++i) {
+    graph += BetweenFactor<Pose2>(X(i), X(i + 1), Pose2(1., 0., M_PI_2),
+                                  noiseModel::Isotropic::Sigma(3, 0.2));
+    initial.insert(X(i + 1), Pose2(i + 0.2, 0.1 * i, 0.3 * i));
+  }
+
+  // Recycling the elimination storage gives the same result, and frees it at the end
+  LevenbergMarquardtParams params;
+  LevenbergMarquardtParams arena;
+  arena.setUseEliminationArena(true);
+  EXPECT(assert_equal(LevenbergMarquardtOptimizer(graph, initial, params).optimize(),
+                      LevenbergMarquardtOptimizer(graph, initial, arena).optimize()));
+  EXPECT(!EliminationArena::Enabled());
+  EXPECT_LONGS_EQUAL(0, EliminationArena::HeldBytes());
 }
 
 /* ************************************************************************* */
@@ -20,6 +20,7 @@
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/BlockSparseRowMatrix.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/base/Matrix.h>
@@ -122,6 +123,16 @@ TEST( GaussianFactorGraphSystem, multiply_getb)
   Vector actualb;
   gfgs.getb(actualb);
   EXPECT(assert_equal(expectedb, actualb, 1e-3));
+
+  // The BSR kernel computes the same products
+  BlockSparseRowMatrix bsr(simpleGFG, keyInfo);
+  GaussianFactorGraphSystem bsrSystem(simpleGFG, dummyPreconditioner, keyInfo,
+                                      lambda, &bsr);
+  Vector bsrAp = Vector::Zero(6), bsrb;
+  bsrSystem.multiply(p, bsrAp);
+  EXPECT(assert_equal(expectedAp, bsrAp, 1e-3));
+  bsrSystem.getb(bsrb);
+  EXPECT(assert_equal(expectedb, bsrb, 1e-3));
 }
 
 /* ************************************************************************* */
@@ -165,6 +176,28 @@ TEST(PCGSolver, blockjacobi) {
   DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
 }
 
+/* ************************************************************************* */
+// Test Block-Jacobi Precondioner with the BSR kernel
+TEST(PCGSolver, bsr) {
+  LevenbergMarquardtParams params;
+  params.linearSolverType = LevenbergMarquardtParams::Iterative;
+  auto pcg = boost::make_shared<PCGSolverParameters>();
+  pcg->blas_kernel_ = ConjugateGradientParameters::BSR;
+  pcg->preconditioner_ =
+      boost::make_shared<BlockJacobiPreconditionerParameters>();
+  params.iterativeParams = pcg;
+
+  NonlinearFactorGraph fg = example::createReallyNonlinearFactorGraph();
+
+  Point2 x0(10, 10);
+  Values c0;
+  c0.insert(X(1), x0);
+
+  Values actualPCG = LevenbergMarquardtOptimizer(fg, c0, params).optimize();
+
+  DOUBLES_EQUAL(0, fg.error(actualPCG), tol);
+}
+
 /* ************************************************************************* */
 // Test Incremental Subgraph PCG Solver
 TEST(PCGSolver, subgraph) {
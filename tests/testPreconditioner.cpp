@@ -24,9 +24,42 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/geometry/Point2.h>
+#include <gtsam/inference/Symbol.h>
 
 using namespace std;
 using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+namespace {
+// A linearized bundle adjustment problem: 6D cameras that each see a few of
+// the 3D points, with a prior on each camera
+GaussianFactorGraph createBundleAdjustment(size_t nrCameras, size_t nrPoints) {
+  srand(3);
+  GaussianFactorGraph gfg;
+  auto measurement = noiseModel::Isotropic::Sigma(2, 0.5);
+  for (size_t c = 0; c < nrCameras; ++c) {
+    gfg.add(X(c), 0.1 * I_6x6, Vector6::Random(), noiseModel::Unit::Create(6));
+    for (size_t k = 0; k < 4; ++k) {
+      const size_t p = (2 * c + k) % nrPoints;
+      gfg.add(X(c), Matrix26::Random(), L(p), Matrix23::Random(),
+              Vector2::Random(), measurement);
+    }
+  }
+  return gfg;
+}
+
+// Check that the preconditioner is M = L*L' = H, the Hessian of the graph
+bool isExact(const Preconditioner& preconditioner,
+             const GaussianFactorGraph& gfg, const KeyInfo& keyInfo) {
+  const Matrix H = gfg.hessian(keyInfo.ordering()).first;
+  const Vector y = Vector::Random(H.rows());
+  Vector z, x;
+  preconditioner.solve(y, z);
+  preconditioner.transposeSolve(z, x);
+  return assert_equal(y, Vector(H * x), 1e-6);
+}
+}
 
 /* ************************************************************************* */
 TEST( PCGsolver, verySimpleLinearSystem) {
@@ -124,6 +157,69 @@ TEST(PCGSolver, simpleLinearSystem) {
 
 }
 
+/* ************************************************************************* */
+TEST(Preconditioner, blockIncompleteCholesky) {
+  const GaussianFactorGraph gfg = createBundleAdjustment(6, 8);
+  const KeyInfo keyInfo(gfg);
+  const map<Key, Vector> lambda;
+
+  // Without a limit on the fill this is a block Cholesky factorization
+  BlockIncompleteCholeskyPreconditioner complete(
+      BlockIncompleteCholeskyPreconditionerParameters(keyInfo.size()));
+  complete.build(gfg, keyInfo, lambda);
+  EXPECT_DOUBLES_EQUAL(0.0, complete.shift(), 1e-12);
+  EXPECT(isExact(complete, gfg, keyInfo));
+
+  // IC(0) keeps the structure of the Hessian
+  BlockIncompleteCholeskyPreconditioner incomplete;
+  incomplete.build(gfg, keyInfo, lambda);
+  EXPECT(incomplete.nrOffDiagonalBlocks() < complete.nrOffDiagonalBlocks());
+
+  // Both solve the system with PCG
+  const VectorValues expected = gfg.optimize();
+  PCGSolverParameters pcg;
+  pcg.setEpsilon_abs(1e-12);
+  pcg.setEpsilon_rel(1e-12);
+  for (size_t fillLevel : {size_t(0), size_t(1), keyInfo.size()}) {
+    pcg.preconditioner_ = boost::make_shared<
+        BlockIncompleteCholeskyPreconditionerParameters>(fillLevel);
+    EXPECT(assert_equal(expected, PCGSolver(pcg).optimize(gfg), 1e-5));
+  }
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, clusterJacobi) {
+  const GaussianFactorGraph gfg = createBundleAdjustment(6, 8);
+  const KeyInfo keyInfo(gfg);
+  const map<Key, Vector> lambda;
+
+  // Schur-Jacobi has one camera per cluster
+  ClusterJacobiPreconditioner schurJacobi;
+  schurJacobi.build(gfg, keyInfo, lambda);
+  EXPECT_LONGS_EQUAL(6, schurJacobi.clusters().size());
+
+  // Cameras that share points are clustered, and a single cluster is the
+  // exact reduced camera system
+  ClusterJacobiPreconditioner pairs(ClusterJacobiPreconditionerParameters(2));
+  pairs.build(gfg, keyInfo, lambda);
+  EXPECT_LONGS_EQUAL(3, pairs.clusters().size());
+  ClusterJacobiPreconditioner all(ClusterJacobiPreconditionerParameters(6));
+  all.build(gfg, keyInfo, lambda);
+  EXPECT_LONGS_EQUAL(1, all.clusters().size());
+  EXPECT(isExact(all, gfg, keyInfo));
+
+  // All solve the system with PCG
+  const VectorValues expected = gfg.optimize();
+  PCGSolverParameters pcg;
+  pcg.setEpsilon_abs(1e-12);
+  pcg.setEpsilon_rel(1e-12);
+  for (size_t clusterSize : {1, 2, 6}) {
+    pcg.preconditioner_ =
+        boost::make_shared<ClusterJacobiPreconditionerParameters>(clusterSize);
+    EXPECT(assert_equal(expected, PCGSolver(pcg).optimize(gfg), 1e-5));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
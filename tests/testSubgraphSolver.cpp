@@ -22,6 +22,7 @@
 #include <gtsam/linear/iterative.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphBuilder.h>
+#include <gtsam/linear/SubgraphCache.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/numericalDerivative.h>
@@ -132,6 +133,47 @@ TEST( SubgraphSolver, constructor3 )
   DOUBLES_EQUAL(0.0, error(Ab, optimized), 1e-5);
 }
 
+/* ************************************************************************* */
+TEST( SubgraphSolver, cache )
+{
+  // Build a planar graph
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  std::tie(Ab, xtrue) = example::planarGraph(N); // A*x-b
+
+  // The spanning tree is only built for the first graph
+  SubgraphCache cache;
+  SubgraphSolver solver1(Ab, kParameters, kOrdering, cache);
+  DOUBLES_EQUAL(0.0, error(Ab, solver1.optimize()), 1e-5);
+  const Subgraph::EdgeIndices edges = cache.subgraph(Ab, kParameters.builderParams).edgeIndices();
+  LONGS_EQUAL(1, cache.nrBuilt());
+
+  // A graph with the same structure but other values reuses it
+  GaussianFactorGraph Ab2;
+  for (const GaussianFactor::shared_ptr& factor : Ab) {
+    auto jacobian = boost::dynamic_pointer_cast<JacobianFactor>(factor->clone());
+    jacobian->getb() *= 2.0;
+    Ab2.push_back(jacobian);
+  }
+  SubgraphSolver solver2(Ab2, kParameters, kOrdering, cache);
+  DOUBLES_EQUAL(0.0, error(Ab2, solver2.optimize()), 1e-5);
+  LONGS_EQUAL(1, cache.nrBuilt());
+  LONGS_EQUAL(2, cache.nrReused());
+  EXPECT(edges == cache.subgraph(Ab2, kParameters.builderParams).edgeIndices());
+
+  // Eliminating the subgraph factors again, with the cached elimination tree
+  GaussianFactorGraph::shared_ptr Ab2tree =
+      splitFactorGraph(Ab2, cache.subgraph(Ab2, kParameters.builderParams)).first;
+  EXPECT(assert_equal(*Ab2tree->eliminateSequential(kOrdering, EliminateQR),
+                      *cache.eliminate(*Ab2tree, kOrdering)));
+
+  // Adding a factor changes the structure
+  Ab2.push_back(Ab2[0]->clone());
+  SubgraphSolver solver3(Ab2, kParameters, kOrdering, cache);
+  DOUBLES_EQUAL(0.0, error(Ab2, solver3.optimize()), 1e-5);
+  LONGS_EQUAL(2, cache.nrBuilt());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -17,7 +17,9 @@
  */
 
 #include <gtsam/base/cholesky.h>
+#include <gtsam/base/TaskGroup.h>
 
+#include <chrono>
 #include <time.h>
 #include <iostream>
 #include <iomanip>      // std::setprecision
@@ -56,5 +58,33 @@ int main() {
     cout << ms << " ms, " << ms/nFrontal << " ms/dim" << endl;
   }
 
+  // Compare the serial and the blocked parallel partial Cholesky on large cliques
+  cout << "\nparallel partialCholesky, " << TaskGroup::MaxConcurrency() << " threads" << endl;
+  typedef std::chrono::steady_clock Clock;
+  const size_t sizes[][2] = {{100, 100}, {200, 400}, {500, 500}, {1000, 1000}, {2000, 1000}};
+  for (const auto& size : sizes) {
+    const size_t nFrontal = size[0], n = size[0] + size[1];
+    const Matrix M = Matrix::Random(n + 10, n);
+    const Matrix SPD = M.transpose() * M;
+    const size_t repeats = std::max(size_t(1), size_t(1e9 / double(n * n * n)));
+
+    double seconds[2];
+    Matrix results[2];
+    for (int parallel = 0; parallel < 2; parallel++) {
+      CholeskyParallelScope scope(parallel == 1);
+      auto start = Clock::now();
+      for (size_t i = 0; i < repeats; i++) {
+        results[parallel] = SPD;
+        choleskyPartial(results[parallel], nFrontal);
+      }
+      seconds[parallel] = std::chrono::duration<double>(Clock::now() - start).count() / repeats;
+    }
+    const double error = (Matrix(results[0].triangularView<Eigen::Upper>()) -
+                          Matrix(results[1].triangularView<Eigen::Upper>())).cwiseAbs().maxCoeff();
+    cout << "frontal " << nFrontal << ", separator " << n - nFrontal << ": serial "
+         << seconds[0] * 1000 << " ms, parallel " << seconds[1] * 1000 << " ms, speedup "
+         << seconds[0] / seconds[1] << ", error " << error << endl;
+  }
+
   return 0;
 }